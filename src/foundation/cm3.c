@@ -52,6 +52,11 @@ void nvic_clear_irq(int irq_no)
 
 }
 
+void nvic_set_priority(int irq_no, unsigned int prio)
+{
+	__raw_writeb(prio, NVIC_IRQ_PRIO + irq_no);
+}
+
 void scr_enable_sleepdeep(void)
 {
 	unsigned int scr_reg;
@@ -71,3 +76,41 @@ void scr_enable_sleeponexit(void)
 
 	__raw_writel(scr_reg, SYS_SCR);
 }
+
+/* Start the DWT cycle counter, returns false if it is not implemented */
+bool dwt_enable(void)
+{
+	if (__raw_readl(DWT_CTRL) & DWT_CTRL_NOCYCCNT)
+		return false;
+
+	__raw_writel(__raw_readl(SYS_DEMCR) | SYS_DEMCR_TRCENA, SYS_DEMCR);
+	__raw_writel(__raw_readl(DWT_CTRL) | DWT_CTRL_CYCCNTENA, DWT_CTRL);
+
+	return true;
+}
+
+unsigned int dwt_cycles(void)
+{
+	return __raw_readl(DWT_CYCCNT);
+}
+
+/*
+ * Busy wait for at least the given number of microseconds. The CM3 clock
+ * drops with the CORE DPLL in bypass so count cycles for the fastest
+ * possible clock, waits will only ever be longer than asked for.
+ */
+void udelay(unsigned int us)
+{
+	unsigned int cycles = us * CM3_MAX_MHZ;
+	unsigned int start;
+
+	if (!dwt_enable()) {
+		while (cycles--)
+			__asm("nop");
+		return;
+	}
+
+	start = dwt_cycles();
+	while (dwt_cycles() - start < cycles)
+		;
+}
@@ -0,0 +1,91 @@
+/*
+ * AM33XX-CM3 firmware
+ *
+ * Cortex-M3 (CM3) firmware for power management on Texas Instruments' AM33XX series of SoCs
+ *
+ * Copyright (C) 2011 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  This software is licensed under the  standard terms and conditions in the Texas Instruments  Incorporated
+ *  Technology and Software Publicly Available Software License Agreement , a copy of which is included in the
+ *  software download.
+*/
+
+#include <device_common.h>
+#include <io.h>
+#include <hwmod.h>
+#include <counter32k.h>
+
+/*
+ * DMTIMER0 runs from the always-on 32K RC oscillator and is not used by
+ * the A8, so keep it free running as a reference that survives MOSC
+ * being turned off.
+ */
+#define DMTIMER0_BASE		DMTIMER_BASE
+
+#define DMTIMER_IRQSTATUS	0x28
+#define DMTIMER_IRQENABLE_SET	0x2c
+#define DMTIMER_IRQENABLE_CLR	0x30
+#define DMTIMER_TCLR		0x38
+#define DMTIMER_TCRR		0x3c
+#define DMTIMER_TLDR		0x40
+#define DMTIMER_TMAR		0x4c
+#define DMTIMER_TSICR		0x54
+
+#define DMTIMER_TCLR_ST		(1 << 0)
+#define DMTIMER_TCLR_AR		(1 << 1)
+#define DMTIMER_TCLR_CE		(1 << 6)
+
+#define DMTIMER_IRQ_MAT		(1 << 0)
+
+void counter32k_init(void)
+{
+	hwmod_enable(HWMOD_TIMER0);
+
+	if (__raw_readl(DMTIMER0_BASE + DMTIMER_TCLR) & DMTIMER_TCLR_ST)
+		return;
+
+	/* Non-posted mode, the counter is read far more often than written */
+	__raw_writel(0, DMTIMER0_BASE + DMTIMER_TSICR);
+	__raw_writel(0, DMTIMER0_BASE + DMTIMER_TLDR);
+	__raw_writel(0, DMTIMER0_BASE + DMTIMER_TCRR);
+	__raw_writel(DMTIMER_TCLR_ST | DMTIMER_TCLR_AR,
+					DMTIMER0_BASE + DMTIMER_TCLR);
+}
+
+unsigned int counter32k_read(void)
+{
+	return __raw_readl(DMTIMER0_BASE + DMTIMER_TCRR);
+}
+
+/* Wait until the given number of 32K edges have been seen */
+void counter32k_wait(unsigned int ticks)
+{
+	unsigned int start = counter32k_read();
+
+	while (counter32k_read() - start < ticks)
+		;
+}
+
+unsigned int counter32k_to_us(unsigned int ticks)
+{
+	/* 1000000 / 32768 reduced to 15625 / 512 */
+	return ticks * 15625 / 512;
+}
+
+/* Raise TINT0 once the given number of 32K edges from now have passed */
+void counter32k_alarm(unsigned int ticks)
+{
+	__raw_writel(counter32k_read() + ticks, DMTIMER0_BASE + DMTIMER_TMAR);
+	__raw_writel(DMTIMER_IRQ_MAT, DMTIMER0_BASE + DMTIMER_IRQSTATUS);
+	__raw_writel(DMTIMER_IRQ_MAT, DMTIMER0_BASE + DMTIMER_IRQENABLE_SET);
+	__raw_writel(__raw_readl(DMTIMER0_BASE + DMTIMER_TCLR) | DMTIMER_TCLR_CE,
+					DMTIMER0_BASE + DMTIMER_TCLR);
+}
+
+void counter32k_alarm_cancel(void)
+{
+	__raw_writel(__raw_readl(DMTIMER0_BASE + DMTIMER_TCLR) & ~DMTIMER_TCLR_CE,
+					DMTIMER0_BASE + DMTIMER_TCLR);
+	__raw_writel(DMTIMER_IRQ_MAT, DMTIMER0_BASE + DMTIMER_IRQENABLE_CLR);
+	__raw_writel(DMTIMER_IRQ_MAT, DMTIMER0_BASE + DMTIMER_IRQSTATUS);
+}
@@ -0,0 +1,113 @@
+/*
+ * AM33XX-CM3 firmware
+ *
+ * Cortex-M3 (CM3) firmware for power management on Texas Instruments' AM33XX series of SoCs
+ *
+ * Copyright (C) 2011 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  This software is licensed under the  standard terms and conditions in the Texas Instruments  Incorporated
+ *  Technology and Software Publicly Available Software License Agreement , a copy of which is included in the
+ *  software download.
+*/
+
+#include <stddef.h>
+#include <cm3.h>
+#include <io.h>
+#include <msg.h>
+#include <sync.h>
+#include <mailbox.h>
+#include <telemetry.h>
+#include <crash.h>
+
+/* The faulting stack may well be what caused the fault */
+#define CRASH_STACK_SIZE	256
+
+extern unsigned int _start_data;
+extern unsigned int _end_stack;
+
+static unsigned int crash_stack[CRASH_STACK_SIZE / 4] __attribute__ ((used));
+
+/*
+ * Record what the CM3 was doing, fail the current command towards the
+ * A8 and stop for good. Interrupts stay disabled, so the WFI below only
+ * ever returns to a debugger.
+ */
+static void __attribute__ ((noreturn)) crash_park(enum crash_reason reason,
+			unsigned int exception, const unsigned int *frame,
+			unsigned int pc)
+{
+	volatile struct crash_record *rec;
+
+	__asm("cpsid i");
+	__raw_writel(0, SYST_CSR);
+
+	rec = telemetry_crash_begin();
+	rec->reason = reason;
+	rec->exception = exception;
+	rec->cmd_id = cmd_global_data.cmd_id;
+	rec->trace = msg_read(TRACE_REG);
+	if (frame) {
+		rec->r0 = frame[0];
+		rec->r1 = frame[1];
+		rec->r2 = frame[2];
+		rec->r3 = frame[3];
+		rec->r12 = frame[4];
+		rec->lr = frame[5];
+		rec->pc = frame[6];
+		rec->xpsr = frame[7];
+	} else {
+		rec->pc = pc;
+	}
+	rec->cfsr = __raw_readl(SYS_CFSR);
+	rec->hfsr = __raw_readl(SYS_HFSR);
+	rec->mmfar = __raw_readl(SYS_MMFAR);
+	rec->bfar = __raw_readl(SYS_BFAR);
+	telemetry_crash_end();
+
+	a8_notify(CMD_STAT_FAIL);
+	mailbox_post(cmd_global_data.cmd_id, CMD_STAT_FAIL);
+
+	__raw_writel(0xffffffff, NVIC_IRQ_CLR_EN1);
+	__raw_writel(0xffffffff, NVIC_IRQ_CLR_EN2);
+	__raw_writel(0xffffffff, NVIC_IRQ_CLR_PEND1);
+	__raw_writel(0xffffffff, NVIC_IRQ_CLR_PEND2);
+
+	scr_enable_sleepdeep();
+	while (1)
+		__asm("wfi");
+}
+
+/* Only trust the stacked frame if it lies within DMEM */
+static void __attribute__ ((used, noreturn))
+crash_fault(const unsigned int *frame)
+{
+	unsigned int ipsr;
+
+	__asm volatile ("mrs %0, ipsr" : "=r" (ipsr));
+
+	if (frame < &_start_data || frame + 8 > &_end_stack)
+		frame = NULL;
+
+	crash_park(CRASH_FAULT, ipsr & 0x1ff, frame, 0);
+}
+
+/*
+ * Common entry of all faults and unexpected exceptions. Picks up the
+ * frame stacked on exception entry and moves to a stack of its own.
+ */
+void __attribute__ ((used, naked)) crash_entry(void)
+{
+	__asm("tst	lr, #4\n\t"
+	      "ite	eq\n\t"
+	      "mrseq	r0, msp\n\t"
+	      "mrsne	r0, psp\n\t"
+	      "ldr	r1, =crash_stack + " __stringify(CRASH_STACK_SIZE) "\n\t"
+	      "mov	sp, r1\n\t"
+	      "b	crash_fault");
+}
+
+/* For conditions the firmware can not recover from */
+void crash(enum crash_reason reason)
+{
+	crash_park(reason, 0, NULL, (unsigned int) __builtin_return_address(0));
+}
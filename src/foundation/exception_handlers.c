@@ -10,59 +10,51 @@
  *  software download.
 */
 
-/* Will be extended in the future as and when required */
-void nmi_handler(void)
+#include <timebase.h>
+#include <crash.h>
+
+/* Faults and exceptions the firmware never uses all end up in the crash path */
+void __attribute__ ((naked)) nmi_handler(void)
 {
-	while(1)
-	;
+	__asm("b	crash_entry");
 }
 
-void hardfault_handler(void)
+void __attribute__ ((naked)) hardfault_handler(void)
 {
-	while(1)
-	;
+	__asm("b	crash_entry");
 }
 
-void memmanage_handler(void)
+void __attribute__ ((naked)) memmanage_handler(void)
 {
-	while(1)
-	;
+	__asm("b	crash_entry");
 }
 
-void busfault_handler(void)
+void __attribute__ ((naked)) busfault_handler(void)
 {
-	while(1)
-	;
+	__asm("b	crash_entry");
 }
 
-void usagefault_handler(void)
+void __attribute__ ((naked)) usagefault_handler(void)
 {
-	while(1)
-	;
+	__asm("b	crash_entry");
 }
 
-void svc_handler(void)
+void __attribute__ ((naked)) svc_handler(void)
 {
-	while(1)
-	;
+	__asm("b	crash_entry");
 }
 
-void debugmon_handler(void)
+void __attribute__ ((naked)) debugmon_handler(void)
 {
-	while(1)
-	;
+	__asm("b	crash_entry");
 }
 
-void pendsv_handler(void)
+void __attribute__ ((naked)) pendsv_handler(void)
 {
-	while(1)
-	;
+	__asm("b	crash_entry");
 }
 
-#if 0
 void systick_handler(void)
 {
-	while(1)
-	;
+	timebase_tick();
 }
-#endif
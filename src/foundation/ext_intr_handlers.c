@@ -16,6 +16,11 @@
 #include <msg.h>
 #include <pm_handlers.h>
 #include <sync.h>
+#include <smartreflex.h>
+#include <state_select.h>
+#include <telemetry.h>
+#include <promote.h>
+#include <crash.h>
 
 /*
  * PRCM_M3_IRQ1: Triggered for events like PLL needs recalibration,
@@ -23,8 +28,25 @@
  */
 void extint16_handler(void)
 {
-	while(1)
-	;
+	crash(CRASH_PRCM_IRQ);
+}
+
+/* TINT0: cpuidle promotion threshold expired */
+void extint18_handler(void)
+{
+	promote_irq_handler();
+}
+
+/* SMRFLX_MPU: SmartReflex average error ready for VDD_MPU */
+void extint29_handler(void)
+{
+	sr_irq_handler(VDD_MPU);
+}
+
+/* SMRFLX_CORE: SmartReflex average error ready for VDD_CORE */
+void extint30_handler(void)
+{
+	sr_irq_handler(VDD_CORE);
 }
 
 /* MBINT0: Triggered on a dummy write to Mailbox module */
@@ -33,6 +55,10 @@ void extint31_handler(void)
 	nvic_disable_irq(CM3_IRQ_MBINT0);
 
 	msg_cmd_read_id();
+	timer_sync_start();
+
+	if (cmd_global_data.cmd_id == CMD_ID_AUTO)
+		state_select_cmd();
 
 	if (!msg_cmd_is_valid()) {
 		/*
@@ -40,9 +66,13 @@ void extint31_handler(void)
 		 * and enable the mailbox interrupt back
 		 */
 		msg_cmd_stat_update(CMD_STAT_FAIL);
+		telemetry_cmd_invalid();
 
 	} else if (msg_cmd_needs_trigger()) {
-		a8_m3_low_power_sync(CMD_STAT_WAIT4OK);
+		if (msg_cmd_prepare())
+			msg_cmd_stat_update(CMD_STAT_FAIL);
+		else
+			a8_m3_low_power_sync(CMD_STAT_WAIT4OK);
 
 	} else if (msg_cmd_fast_trigger()) {
 		a8_m3_low_power_fast(CMD_STAT_PASS);
@@ -52,6 +82,8 @@ void extint31_handler(void)
 		msg_cmd_dispatcher();
 	}
 
+	timer_sync();
+
 	nvic_enable_irq(CM3_IRQ_MBINT0);
 }
 
@@ -65,20 +97,18 @@ void extint33_handler(void)
 /* PRCM_M3_IRQ2: Triggered when A8 executes WFI */
 void extint34_handler(void)
 {
-	int i;
+	sr_suspend();
 
 	/* Flush out ALL the NVIC interrupts */
-	for (i = 0; i < CM3_NUM_EXT_INTERRUPTS; i++)
-	{
-		nvic_disable_irq(i);
-		nvic_clear_irq(i);
-	}
-	if (soc_id == AM43XX_SOC_ID) {
-		nvic_disable_irq(CM3_IRQ_TPM_WAKE);
-		nvic_clear_irq(CM3_IRQ_TPM_WAKE);
-	}
+	pm_nvic_flush();
+
+	telemetry_entry_start(cmd_global_data.cmd_id);
+
+	pm_entry_begin();
 
 	msg_cmd_dispatcher();
+
+	pm_entry_end();
 }
 
 /* USB0WOUT */
@@ -192,6 +222,10 @@ void extint53_handler(void)
 	nvic_disable_irq(53);
 
 	msg_cmd_read_id();
+	timer_sync_start();
+
+	if (cmd_global_data.cmd_id == CMD_ID_AUTO)
+		state_select_cmd();
 
 	/*
 	 * If command is not valid, need to update the status to FAIL
@@ -199,15 +233,21 @@ void extint53_handler(void)
 	 */
 	if (!msg_cmd_is_valid()) {
 		msg_cmd_stat_update(CMD_STAT_FAIL);
+		telemetry_cmd_invalid();
 
 	} else if (msg_cmd_needs_trigger()) {
 		/* cmd was valid */
-		a8_m3_low_power_sync(CMD_STAT_WAIT4OK);
+		if (msg_cmd_prepare())
+			msg_cmd_stat_update(CMD_STAT_FAIL);
+		else
+			a8_m3_low_power_sync(CMD_STAT_WAIT4OK);
 
 	} else {
 		/* For Rev and S/M reset */
 		msg_cmd_dispatcher();
 	}
 
+	timer_sync();
+
 	nvic_enable_irq(53);
 }
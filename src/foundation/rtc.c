@@ -10,18 +10,19 @@
  *  software download.
 */
 
+#include <stddef.h>
 #include <device_common.h>
 #include <io.h>
 #include <clockdomain.h>
 #include <rtc.h>
+#include <crash.h>
 
 int rtc_enable_check(void)
 {
-	if (clkdm_active(CLKDM_RTC))
-		return 0;
-	else
-		while(1)
-		;
+	if (!clkdm_active(CLKDM_RTC))
+		crash(CRASH_RTC_DISABLED);
+
+	return 0;
 }
 
 void rtc_reg_write(unsigned int val, int reg)
@@ -33,3 +34,176 @@ unsigned int rtc_reg_read(int reg)
 {
 	return __raw_readl(reg + RTCSS_BASE);
 }
+
+static unsigned int bcd2bin(unsigned int val)
+{
+	return (val & 0xf) + (val >> 4) * 10;
+}
+
+static unsigned int bin2bcd(unsigned int val)
+{
+	return ((val / 10) << 4) | (val % 10);
+}
+
+static bool rtc_leap_year(unsigned int year)
+{
+	/* 2000 is a leap year, no century rule needed up to 2099 */
+	return !(year % 4);
+}
+
+static unsigned int rtc_month_days(unsigned int month, unsigned int year)
+{
+	static const unsigned char days[] = {
+		31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31,
+	};
+
+	if (month == 2 && rtc_leap_year(year))
+		return 29;
+
+	return days[month - 1];
+}
+
+/*
+ * reg is the seconds register of the time or one of the alarms, the
+ * other fields follow it in the same order. The time registers must
+ * only be read while the RTC is not about to update them.
+ */
+void rtc_time_read(int reg, struct rtc_time *tm)
+{
+	if (reg == RTC_SECONDS_REG)
+		while (rtc_reg_read(RTC_STATUS_REG) & RTC_STATUS_BUSY);
+
+	tm->sec = bcd2bin(rtc_reg_read(reg + 0x00) & 0x7f);
+	tm->min = bcd2bin(rtc_reg_read(reg + 0x04) & 0x7f);
+	tm->hour = bcd2bin(rtc_reg_read(reg + 0x08) & 0x3f);
+	tm->day = bcd2bin(rtc_reg_read(reg + 0x0c) & 0x3f);
+	tm->month = bcd2bin(rtc_reg_read(reg + 0x10) & 0x1f);
+	tm->year = bcd2bin(rtc_reg_read(reg + 0x14) & 0xff);
+}
+
+void rtc_time_write(int reg, const struct rtc_time *tm)
+{
+	rtc_reg_write(bin2bcd(tm->sec), reg + 0x00);
+	rtc_reg_write(bin2bcd(tm->min), reg + 0x04);
+	rtc_reg_write(bin2bcd(tm->hour), reg + 0x08);
+	rtc_reg_write(bin2bcd(tm->day), reg + 0x0c);
+	rtc_reg_write(bin2bcd(tm->month), reg + 0x10);
+	rtc_reg_write(bin2bcd(tm->year), reg + 0x14);
+}
+
+/* Seconds since 2000-01-01 00:00:00 */
+unsigned int rtc_time_to_secs(const struct rtc_time *tm)
+{
+	unsigned int days = tm->day - 1;
+	unsigned int i;
+
+	for (i = 0; i < tm->year; i++)
+		days += rtc_leap_year(i) ? 366 : 365;
+
+	for (i = 1; i < tm->month; i++)
+		days += rtc_month_days(i, tm->year);
+
+	return ((days * 24 + tm->hour) * 60 + tm->min) * 60 + tm->sec;
+}
+
+void rtc_secs_to_time(unsigned int secs, struct rtc_time *tm)
+{
+	unsigned int days = secs / 86400;
+	unsigned int len;
+
+	secs %= 86400;
+	tm->hour = secs / 3600;
+	tm->min = (secs / 60) % 60;
+	tm->sec = secs % 60;
+
+	for (tm->year = 0; ; tm->year++) {
+		len = rtc_leap_year(tm->year) ? 366 : 365;
+		if (days < len)
+			break;
+		days -= len;
+	}
+
+	for (tm->month = 1; ; tm->month++) {
+		len = rtc_month_days(tm->month, tm->year);
+		if (days < len)
+			break;
+		days -= len;
+	}
+
+	tm->day = days + 1;
+}
+
+/* Fails if the result does not fit the RTC */
+int rtc_time_add(struct rtc_time *tm, unsigned int secs)
+{
+	unsigned int now = rtc_time_to_secs(tm);
+
+	if (secs > RTC_SECS_MAX - now)
+		return -1;
+
+	rtc_secs_to_time(now + secs, tm);
+
+	return 0;
+}
+
+/*
+ * The KICK registers are write only, so the lock state the kernel left
+ * can not be saved. Like the RTC mode writes, leave the RTC unlocked:
+ * relocking it would drop those writes and the kernel's own.
+ */
+static void rtc_unlock(void)
+{
+	rtc_reg_write(RTC_KICK0_VAL, RTC_KICK0);
+	rtc_reg_write(RTC_KICK1_VAL, RTC_KICK1);
+}
+
+/*
+ * Program the wake alarm, secs is either seconds from now or seconds
+ * since 2000-01-01 00:00:00. The RTC alarm has a resolution of one
+ * second, a relative alarm fires within one second short of secs.
+ */
+int rtc_alarm_set(unsigned int secs, bool absolute)
+{
+	struct rtc_time tm;
+
+	if (!clkdm_active(CLKDM_RTC))
+		return -1;
+
+	rtc_time_read(RTC_SECONDS_REG, &tm);
+
+	if (absolute) {
+		if (secs <= rtc_time_to_secs(&tm) || secs > RTC_SECS_MAX)
+			return -1;
+		rtc_secs_to_time(secs, &tm);
+	} else if (!secs || rtc_time_add(&tm, secs)) {
+		return -1;
+	}
+
+	rtc_unlock();
+
+	rtc_time_write(RTC_ALARM_SECONDS_REG, &tm);
+	rtc_reg_write(RTC_STATUS_ALARM, RTC_STATUS_REG);
+	rtc_reg_write(rtc_reg_read(RTC_INTERRUPTS_REG) | RTC_INTERRUPTS_IT_ALARM,
+							RTC_INTERRUPTS_REG);
+	rtc_reg_write(rtc_reg_read(RTC_IRQWAKEEN_0) | RTC_IRQWAKEEN_ALARM,
+							RTC_IRQWAKEEN_0);
+
+	return 0;
+}
+
+/* Someone else, usually the kernel RTC driver, has an alarm pending */
+bool rtc_alarm_busy(void)
+{
+	return rtc_reg_read(RTC_INTERRUPTS_REG) & RTC_INTERRUPTS_IT_ALARM;
+}
+
+void rtc_alarm_clear(void)
+{
+	rtc_unlock();
+
+	rtc_reg_write(rtc_reg_read(RTC_INTERRUPTS_REG) & ~RTC_INTERRUPTS_IT_ALARM,
+							RTC_INTERRUPTS_REG);
+	rtc_reg_write(rtc_reg_read(RTC_IRQWAKEEN_0) & ~RTC_IRQWAKEEN_ALARM,
+							RTC_IRQWAKEEN_0);
+	rtc_reg_write(RTC_STATUS_ALARM, RTC_STATUS_REG);
+}
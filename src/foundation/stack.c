@@ -0,0 +1,32 @@
+/*
+ * AM33XX-CM3 firmware
+ *
+ * Cortex-M3 (CM3) firmware for power management on Texas Instruments' AM33XX series of SoCs
+ *
+ * Copyright (C) 2011 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  This software is licensed under the  standard terms and conditions in the Texas Instruments  Incorporated
+ *  Technology and Software Publicly Available Software License Agreement , a copy of which is included in the
+ *  software download.
+*/
+
+#include <stack.h>
+
+extern unsigned int _end_bss;
+extern unsigned int _end_stack;
+
+unsigned int stack_size(void)
+{
+	return (&_end_stack - &_end_bss) * 4;
+}
+
+/* Deepest the stack has been since reset, in bytes */
+unsigned int stack_high_water(void)
+{
+	unsigned int *p = &_end_bss;
+
+	while (p < &_end_stack && *p == STACK_PAINT)
+		p++;
+
+	return (&_end_stack - p) * 4;
+}
@@ -11,6 +11,7 @@
 */
 
 #include <stddef.h>
+#include <stack.h>
 
 extern unsigned int _end_stack;
 extern unsigned int _end_text;
@@ -89,7 +90,7 @@ void extint53_handler(void) 	__attribute__ ((weak, alias("dummy_handler")));
 void dummy_handler(void);
 
 /* the vector table */
-void *vector_table[] __attribute__ ((section(".vectors"))) = {
+void *vector_table[] __attribute__ ((used, section(".vectors"))) = {
 	&_end_stack,
 	reset_handler,
 	nmi_handler,
@@ -191,14 +192,27 @@ void reset_handler(void)
 	      "        strlt   r2, [r0], #4\n"
 	      "        blt     zero_loop");
 
+	/*
+	 * paint the free DMEM below the current frame, stack_high_water()
+	 * looks for the deepest word that got overwritten since.
+	 */
+	__asm("    ldr     r0, =_end_bss\n"
+	      "    mov     r1, sp\n"
+	      "    ldr     r2, =" __stringify(STACK_PAINT) "\n"
+	      "    .thumb_func\n"
+	      "paint_loop:\n"
+	      "        cmp     r0, r1\n"
+	      "        it      lt\n"
+	      "        strlt   r2, [r0], #4\n"
+	      "        blt     paint_loop");
+
 	/*
 	 * call the application's entry point.
 	 */
 	main();
 }
 
-void dummy_handler(void)
+void __attribute__ ((naked)) dummy_handler(void)
 {
-	while(1)
-	;
+	__asm("b	crash_entry");
 }
@@ -0,0 +1,180 @@
+/*
+ * AM33XX-CM3 firmware
+ *
+ * Cortex-M3 (CM3) firmware for power management on Texas Instruments' AM33XX series of SoCs
+ *
+ * Copyright (C) 2011 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  This software is licensed under the  standard terms and conditions in the Texas Instruments  Incorporated
+ *  Technology and Software Publicly Available Software License Agreement , a copy of which is included in the
+ *  software download.
+*/
+
+
+#include <stddef.h>
+#include <cm3.h>
+#include <io.h>
+#include <dpll.h>
+#include <counter32k.h>
+#include <timebase.h>
+
+/*
+ * The 32K counter runs from the RC oscillator, which can be off from
+ * 32768Hz by a wide margin. Its period is measured in us against the
+ * CM3 clock, which the CORE DPLL derives from the crystal, kept as a
+ * 16.16 fixed point value. Nominal is 1000000 / 32768 us.
+ */
+#define TIMEBASE_US_NOMINAL	2000000
+static unsigned int us_per_tick = TIMEBASE_US_NOMINAL;
+
+/* Last raw value and the upper 32 bits of both counters */
+static unsigned int ticks_last;
+static unsigned int ticks_hi;
+static unsigned int cycles_last;
+static unsigned int cycles_hi;
+
+static bool have_cycles;
+
+static unsigned int irq_save(void)
+{
+	unsigned int primask;
+
+	__asm volatile ("mrs %0, primask\n\tcpsid i" : "=r" (primask));
+
+	return primask;
+}
+
+static void irq_restore(unsigned int primask)
+{
+	__asm volatile ("msr primask, %0" : : "r" (primask));
+}
+
+void timebase_init(void)
+{
+	have_cycles = dwt_enable();
+
+	ticks_last = counter32k_read();
+	ticks_hi = 0;
+	cycles_last = have_cycles ? dwt_cycles() : 0;
+	cycles_hi = 0;
+
+	timebase_calibrate();
+
+	/*
+	 * A full SysTick period is 2^24 CM3 cycles, the cycle counter can
+	 * not wrap twice in between. SysTick stops with the CM3 clock in
+	 * deep sleep, so it costs no wakeups.
+	 */
+	__raw_writeb(NVIC_PRIO_LOW, SYS_SHPR3_SYSTICK);
+	__raw_writel(SYST_RVR_MAX, SYST_RVR);
+	__raw_writel(0, SYST_CVR);
+	__raw_writel(SYST_CSR_ENABLE | SYST_CSR_TICKINT | SYST_CSR_CLKSOURCE,
+								SYST_CSR);
+}
+
+/*
+ * Only valid with the CORE DPLL locked, the CM3 clock is derived from
+ * its setup. Otherwise the nominal period is kept.
+ */
+void timebase_calibrate(void)
+{
+	unsigned int khz = cm3_clk_khz();
+	unsigned int start;
+	unsigned int cycles;
+	unsigned int us;
+
+	if (!have_cycles || !khz)
+		return;
+
+	/* Start on an edge */
+	counter32k_wait(1);
+
+	start = dwt_cycles();
+	counter32k_wait(TIMEBASE_CAL_TICKS);
+	cycles = dwt_cycles() - start;
+
+	us = cycles / khz * 1000 + cycles % khz * 1000 / khz;
+	us *= 65536 / TIMEBASE_CAL_TICKS;
+
+	/* Way off means the CM3 was not where we thought it was */
+	if (us > TIMEBASE_US_NOMINAL / 2 && us < TIMEBASE_US_NOMINAL * 2)
+		us_per_tick = us;
+}
+
+/* The 32K counter wraps after 36 hours, the cycle counter much sooner */
+static void timebase_update(void)
+{
+	unsigned int now;
+
+	now = counter32k_read();
+	if (now < ticks_last)
+		ticks_hi++;
+	ticks_last = now;
+
+	if (have_cycles) {
+		now = dwt_cycles();
+		if (now < cycles_last)
+			cycles_hi++;
+		cycles_last = now;
+	}
+}
+
+void timebase_tick(void)
+{
+	unsigned int flags = irq_save();
+
+	timebase_update();
+
+	irq_restore(flags);
+}
+
+/*
+ * 32K ticks. A single low power state longer than 36 hours loses a
+ * wrap, anything shorter is caught on the next read.
+ */
+unsigned long long timebase_ticks(void)
+{
+	unsigned int flags = irq_save();
+	unsigned long long ticks;
+
+	timebase_update();
+	ticks = ((unsigned long long) ticks_hi << 32) | ticks_last;
+
+	irq_restore(flags);
+
+	return ticks;
+}
+
+/* CM3 cycles, only advance while the CM3 is clocked */
+unsigned long long timebase_cycles(void)
+{
+	unsigned int flags = irq_save();
+	unsigned long long cycles;
+
+	timebase_update();
+	cycles = ((unsigned long long) cycles_hi << 32) | cycles_last;
+
+	irq_restore(flags);
+
+	return cycles;
+}
+
+unsigned int timebase_ticks_to_us(unsigned int ticks)
+{
+	return ((unsigned long long) ticks * us_per_tick) >> 16;
+}
+
+/* Calibrated 32K rate, 1000000 is 15625 << 6 so this fits 32 bits */
+unsigned int timebase_tick_hz(void)
+{
+	return (15625 << 16) / (us_per_tick >> 6);
+}
+
+/* Calibrated time since init, no 64 bit division needed */
+unsigned long long timebase_us(void)
+{
+	unsigned long long ticks = timebase_ticks();
+
+	return (ticks >> 16) * us_per_tick +
+		(((ticks & 0xffff) * us_per_tick) >> 16);
+}
@@ -42,7 +42,11 @@ void clkdm_sleep(enum clkdm_id id);
 void clkdm_wake(enum clkdm_id id);
 void clkdms_sleep(void);
 void clkdms_wake(void);
+void clkdms_wake_critical(void);
+void clkdms_sleep_deferred(void);
+void clkdms_wake_deferred(void);
 bool clkdm_active(enum clkdm_id id);
+bool clkdm_sleeping(enum clkdm_id id);
 
 #endif
 
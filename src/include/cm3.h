@@ -13,6 +13,8 @@
 #ifndef __CM3_H__
 #define __CM3_H__
 
+#include <stddef.h>
+
 #define NVIC_BASE		0xE000E100
 
 #define NVIC_IRQ_SET_EN1	(NVIC_BASE + 0x0)
@@ -31,16 +33,58 @@
 #define NVIC_IRQ_CLR_PEND2	(NVIC_BASE + 0x184)
 #define NVIC_IRQ_CLR_PEND3	(NVIC_BASE + 0x188)
 
+#define NVIC_IRQ_PRIO		(NVIC_BASE + 0x300)
+
+/* Lower values preempt higher ones, only the top bits are implemented */
+#define NVIC_PRIO_HIGH		0x00
+#define NVIC_PRIO_LOW		0x80
+
 #define SYS_CONTROL_BASE	0xE000ED00
 
 #define SYS_SCR			(SYS_CONTROL_BASE + 0x10)
 #define SYS_SCR_SD_OFFSET	0x2
 #define SYS_SCR_SOE_OFFSET	0x1
 
+/* Configurable fault status and fault address registers */
+#define SYS_CFSR		(SYS_CONTROL_BASE + 0x28)
+#define SYS_HFSR		(SYS_CONTROL_BASE + 0x2c)
+#define SYS_MMFAR		(SYS_CONTROL_BASE + 0x34)
+#define SYS_BFAR		(SYS_CONTROL_BASE + 0x38)
+
+/* System handler priority 15, SysTick */
+#define SYS_SHPR3_SYSTICK	(SYS_CONTROL_BASE + 0x23)
+
+#define SYST_BASE		0xE000E010
+
+#define SYST_CSR		(SYST_BASE + 0x0)
+#define SYST_CSR_ENABLE		(1 << 0)
+#define SYST_CSR_TICKINT	(1 << 1)
+#define SYST_CSR_CLKSOURCE	(1 << 2)
+#define SYST_RVR		(SYST_BASE + 0x4)
+#define SYST_RVR_MAX		0xffffff
+#define SYST_CVR		(SYST_BASE + 0x8)
+
+#define SYS_DEMCR		0xE000EDFC
+#define SYS_DEMCR_TRCENA	(1 << 24)
+
+#define DWT_BASE		0xE0001000
+
+#define DWT_CTRL		(DWT_BASE + 0x0)
+#define DWT_CTRL_CYCCNTENA	(1 << 0)
+#define DWT_CTRL_NOCYCCNT	(1 << 25)
+#define DWT_CYCCNT		(DWT_BASE + 0x4)
+
+/* Highest CM3 clock, CORE_CLKOUTM4 / 2 with the CORE DPLL locked */
+#define CM3_MAX_MHZ		100
+
 void nvic_enable_irq(int);
 void nvic_disable_irq(int);
 void nvic_clear_irq(int);
+void nvic_set_priority(int, unsigned int);
 void scr_enable_sleepdeep(void);
 void scr_enable_sleeponexit(void);
+bool dwt_enable(void);
+unsigned int dwt_cycles(void);
+void udelay(unsigned int);
 
 #endif
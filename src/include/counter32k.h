@@ -0,0 +1,25 @@
+/*
+ * AM33XX-CM3 firmware
+ *
+ * Cortex-M3 (CM3) firmware for power management on Texas Instruments' AM33XX series of SoCs
+ *
+ * Copyright (C) 2011 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  This software is licensed under the  standard terms and conditions in the Texas Instruments  Incorporated
+ *  Technology and Software Publicly Available Software License Agreement , a copy of which is included in the
+ *  software download.
+*/
+
+#ifndef __COUNTER32K_H__
+#define __COUNTER32K_H__
+
+#define COUNTER32K_HZ		32768
+
+void counter32k_init(void);
+unsigned int counter32k_read(void);
+void counter32k_wait(unsigned int ticks);
+unsigned int counter32k_to_us(unsigned int ticks);
+void counter32k_alarm(unsigned int ticks);
+void counter32k_alarm_cancel(void);
+
+#endif
@@ -0,0 +1,57 @@
+/*
+ * AM33XX-CM3 firmware
+ *
+ * Cortex-M3 (CM3) firmware for power management on Texas Instruments' AM33XX series of SoCs
+ *
+ * Copyright (C) 2011 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  This software is licensed under the  standard terms and conditions in the Texas Instruments  Incorporated
+ *  Technology and Software Publicly Available Software License Agreement , a copy of which is included in the
+ *  software download.
+*/
+
+#ifndef __CRASH_H__
+#define __CRASH_H__
+
+#define CRASH_MAGIC		0x48535243	/* "CRSH" */
+
+enum crash_reason {
+	CRASH_NONE,
+	CRASH_FAULT,		/* CPU exception, see exception */
+	CRASH_RTC_DISABLED,	/* RTC access with its clockdomain off */
+	CRASH_JOURNAL_FULL,	/* Entry journal overflow */
+	CRASH_PRCM_IRQ,		/* Unexpected PRCM_M3_IRQ1 */
+	CRASH_HALT_ON_RESUME,	/* Debug halt in the wake path */
+	CRASH_STACK_OVERFLOW,	/* Stack reached .bss */
+};
+
+/*
+ * Written once into the telemetry block, the CM3 never leaves the crash
+ * path, so the A8 can read it until it reloads the firmware. For faults
+ * the registers are the ones stacked on exception entry, for the other
+ * reasons only pc is valid and points at the caller of crash().
+ */
+struct crash_record {
+	unsigned int magic;		/* CRASH_MAGIC once written */
+	unsigned short reason;
+	unsigned short exception;	/* IPSR number, 0 if not a fault */
+	unsigned int cmd_id;
+	unsigned int trace;		/* TRACE_REG at the time */
+	unsigned int r0;
+	unsigned int r1;
+	unsigned int r2;
+	unsigned int r3;
+	unsigned int r12;
+	unsigned int lr;
+	unsigned int pc;
+	unsigned int xpsr;
+	unsigned int cfsr;
+	unsigned int hfsr;
+	unsigned int mmfar;
+	unsigned int bfar;
+};
+
+void crash_entry(void);
+void crash(enum crash_reason reason) __attribute__ ((noreturn));
+
+#endif
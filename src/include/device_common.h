@@ -26,6 +26,7 @@
 #define SR0_BASE	0x44E37000
 #define SR1_BASE	0x44E39000
 #define RTCSS_BASE	0x44E3E000
+#define MAILBOX_BASE	0x480C8000
 
 #define CONTROL_STATUS	(CONTROL_BASE + 0x0040)
 
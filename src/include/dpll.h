@@ -43,20 +43,31 @@ struct dpll_regs {
 	unsigned int clkmode_reg;
 	unsigned int idlest_reg;
 	unsigned int clksel_reg;
+	unsigned int div_m2_reg;
+	unsigned int div_m4_reg;
 };
 
 void plls_power_down(void);
 void plls_power_up(void);
+void plls_pon_start(void);
+bool plls_pon_done(void);
+void plls_pgood_start(void);
+bool plls_pgood_done(void);
+void plls_power_up_finish(void);
 
 void pll_bypass(enum dpll_id dpll);
 void pll_lock(enum dpll_id dpll);
+void plls_bypass(const enum dpll_id *ids);
+void plls_lock(const enum dpll_id *ids);
 
+bool dpll_is_locked(enum dpll_id dpll);
 unsigned int dpll_get_div(enum dpll_id dpll);
 
 void dpll_reset(void);
 void dpll_init(void);
 
 unsigned int get_master_xtal_khz(void);
+unsigned int cm3_clk_khz(void);
 
 #endif
 
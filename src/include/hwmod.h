@@ -27,10 +27,16 @@ enum hwmod_id {
 	HWMOD_L4FW,
 	HWMOD_L4HS,
 	HWMOD_L4LS,
+	HWMOD_MAILBOX0,
 	HWMOD_MPU,
 	HWMOD_OCMCRAM,
 	HWMOD_OTFA_EMIF,
 	HWMOD_OCPWP,
+	HWMOD_SMARTREFLEX0,
+	HWMOD_SMARTREFLEX1,
+	HWMOD_TIMER0,
+	HWMOD_TIMER1,
+	HWMOD_UART0,
 
 	HWMOD_COUNT,
 	HWMOD_END = -1,
@@ -17,6 +17,8 @@
 #define __raw_writel(v, a)	(*(volatile unsigned int *)(a) = v)
 #define __raw_readw(a)		(*(volatile unsigned short *)(a))
 #define __raw_writew(v, a)	(*(volatile unsigned short *)(a) = v)
+#define __raw_readb(a)		(*(volatile unsigned char *)(a))
+#define __raw_writeb(v, a)	(*(volatile unsigned char *)(a) = v)
 
 static inline unsigned int var_mod(unsigned int var, unsigned int mask,
 							unsigned int bit_val)
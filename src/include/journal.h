@@ -0,0 +1,52 @@
+/*
+ * AM33XX-CM3 firmware
+ *
+ * Cortex-M3 (CM3) firmware for power management on Texas Instruments' AM33XX series of SoCs
+ *
+ * Copyright (C) 2011 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  This software is licensed under the  standard terms and conditions in the Texas Instruments  Incorporated
+ *  Technology and Software Publicly Available Software License Agreement , a copy of which is included in the
+ *  software download.
+*/
+
+#ifndef __JOURNAL_H__
+#define __JOURNAL_H__
+
+#include <stddef.h>
+
+/*
+ * Undo journal of the low power entry. While it is open, the PRCM
+ * primitives push one record for every state change they make. The wake
+ * path pops the records, undoing the entry in exact reverse order.
+ */
+enum journal_op {
+	JOURNAL_PD_STATE,		/* pd_state_change(), arg: powerdomain */
+	JOURNAL_CLKDM,			/* clkdm_sleep(), arg: clockdomain */
+	JOURNAL_CLKDMS,			/* clkdms_sleep() */
+	JOURNAL_HWMOD,			/* hwmod_disable(), arg: hwmod */
+	JOURNAL_ESSENTIAL_HWMODS,	/* essential_hwmods_disable() */
+	JOURNAL_INTERCONNECT,		/* interconnect_hwmods_disable() */
+	JOURNAL_PLL_BYPASS,		/* pll_bypass(), arg: dpll */
+	JOURNAL_PLLS,			/* plls_power_down() */
+	JOURNAL_LDO,			/* ldo_power_down(), arg: ldo */
+	JOURNAL_MOSC,			/* disable_master_oscillator() */
+	JOURNAL_VDD,			/* pmic_vdd_lower(), arg: vdd */
+	JOURNAL_WAKE_SOURCES,		/* configure_wake_sources() */
+	JOURNAL_I2C_SLEEP,		/* a8_i2c_sleep_handler() */
+	JOURNAL_DDR,			/* ds_save() */
+};
+
+/* The deepest entry sequence (DS0) needs less than half of this */
+#define JOURNAL_DEPTH		24
+
+void journal_open(void);
+void journal_resume(void);
+void journal_close(void);
+void journal_hold(void);
+void journal_release(void);
+void journal_push(enum journal_op op, int arg);
+bool journal_pop(enum journal_op *op, int *arg);
+bool journal_contains(enum journal_op op, int arg);
+
+#endif
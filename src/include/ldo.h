@@ -13,6 +13,8 @@
 #ifndef __LDO_H__
 #define __LDO_H__
 
+#include <stddef.h>
+
 enum ldo_id {
 	LDO_CORE,
 	LDO_MPU,
@@ -20,6 +22,7 @@ enum ldo_id {
 	LDO_COUNT,
 };
 
+bool ldo_is_on(enum ldo_id id);
 void ldo_wait_for_on(enum ldo_id id);
 void ldo_wait_for_ret(enum ldo_id id);
 void ldo_power_up(enum ldo_id id);
@@ -0,0 +1,36 @@
+/*
+ * AM33XX-CM3 firmware
+ *
+ * Cortex-M3 (CM3) firmware for power management on Texas Instruments' AM33XX series of SoCs
+ *
+ * Copyright (C) 2011 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  This software is licensed under the  standard terms and conditions in the Texas Instruments  Incorporated
+ *  Technology and Software Publicly Available Software License Agreement , a copy of which is included in the
+ *  software download.
+*/
+
+#ifndef __MAILBOX_H__
+#define __MAILBOX_H__
+
+/*
+ * Nothing is posted until the A8 picks a FIFO with CMD_ID_MAILBOX_CONFIG.
+ * The MPU enables the new message interrupt of its mailbox user for that
+ * FIFO and drains it.
+ *
+ * 31-16 = Sequence number, a gap means messages were dropped
+ * 15-8  = CMD_STAT_* value
+ *  7-0  = Command ID
+ */
+#define MAILBOX_FIFO_COUNT	8
+#define MAILBOX_FIFO_NONE	0xffffffff
+
+#define MAILBOX_MSG_SEQ_SHIFT	16
+#define MAILBOX_MSG_STAT_SHIFT	8
+#define MAILBOX_MSG_STAT_MASK	(0xff << 8)
+#define MAILBOX_MSG_CMD_MASK	(0xff << 0)
+
+int mailbox_configure(unsigned int fifo);
+void mailbox_post(unsigned int cmd_id, unsigned int stat);
+
+#endif
@@ -50,6 +50,13 @@
 #define CMD_STAT_PASS		0x0
 #define CMD_STAT_FAIL		0x1
 #define CMD_STAT_WAIT4OK	0x2
+#define CMD_STAT_ABORT		0x3
+
+/* Set in TRACE_REG while a fast resume still restores non-critical state */
+#define TRACE_RESUME_PENDING	(1 << 8)
+
+/* Set in TRACE_REG if a cpuidle v2 entry kept the MPU DPLL locked */
+#define TRACE_IDLE_SHALLOW	(1 << 9)
 
 
 enum cmd_ids {
@@ -69,6 +76,16 @@ enum cmd_ids {
 	CMD_ID_RESET		= 0xe,
 	CMD_ID_VERSION		= 0xf,
 	CMD_ID_CPUIDLE		= 0x10,
+	CMD_ID_PMIC_CONFIG	= 0x11,
+	CMD_ID_AVS		= 0x12,
+	CMD_ID_AUTO		= 0x13,
+	CMD_ID_PROMOTE_CONFIG	= 0x14,
+	CMD_ID_STANDBY_RET	= 0x15,
+	CMD_ID_RTC_DDR		= 0x16,
+	CMD_ID_RTC_ALARM	= 0x17,
+	CMD_ID_WAKE_TIMER	= 0x18,
+	CMD_ID_DS_COUNT_CONFIG	= 0x19,
+	CMD_ID_MAILBOX_CONFIG	= 0x1a,
 	CMD_ID_COUNT,
 };
 
@@ -87,7 +104,8 @@ struct deep_sleep_data {
 	unsigned int pd_mpu_ram_ret_state :1;	/* Sabertooth RAM in retention state */
 	unsigned int pd_mpu_l1_ret_state :1;	/* L1 memory in retention state */
 	unsigned int pd_mpu_l2_ret_state :1;	/* L2 memory in retention state */
-	unsigned int res1 :2;
+	unsigned int fast_resume :1;		/* Release MPU before non-critical restores */
+	unsigned int res1 :1;
 
 	unsigned int pd_per_state :2;	 	/* Powerstate of PD_PER */
 	unsigned int pd_per_icss_mem_ret_state :1; /* ICSS memory in retention state */
@@ -123,6 +141,7 @@ struct cmd_data {
 struct state_handler {
 	union state_data *gp_data;
 	union state_data *hs_data;
+	int (*prepare_handler)(struct cmd_data *data);
 	void (*cmd_handler)(struct cmd_data *data);
 	void (*wake_handler)(void);
 	bool needs_trigger;
@@ -146,11 +165,15 @@ unsigned int msg_read(char);
 void msg_write(unsigned int, char);
 
 void msg_cmd_read_id(void);
+int msg_cmd_prepare(void);
 bool msg_cmd_is_valid(void);
 bool msg_cmd_needs_trigger(void);
 bool msg_cmd_fast_trigger(void);
 void msg_cmd_dispatcher(void);
 void msg_cmd_stat_update(int);
+void msg_cmd_id_update(int);
 void msg_cmd_wakeup_reason_update(int);
+void msg_resume_pending_update(bool);
+void msg_idle_shallow_update(bool);
 
 #endif
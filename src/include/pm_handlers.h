@@ -16,6 +16,10 @@
 struct cmd_data;
 
 void a8_lp_rtc_handler(struct cmd_data *);
+int a8_rtc_fast_prepare_handler(struct cmd_data *);
+void a8_lp_rtc_fast_handler(struct cmd_data *);
+int a8_rtc_ddr_prepare_handler(struct cmd_data *);
+void a8_lp_rtc_ddr_handler(struct cmd_data *);
 void a8_lp_ds0_handler(struct cmd_data *);
 void a8_lp_ds1_handler(struct cmd_data *);
 void a8_lp_ds2_handler(struct cmd_data *);
@@ -23,7 +27,18 @@ void a8_standalone_handler(struct cmd_data *);
 void a8_standby_handler(struct cmd_data *);
 void a8_cpuidle_handler(struct cmd_data *);
 void a8_cpuidle_v2_handler(struct cmd_data *);
+void a8_pmic_config_handler(struct cmd_data *);
+void a8_avs_handler(struct cmd_data *);
+void a8_promote_config_handler(struct cmd_data *);
+void a8_rtc_alarm_handler(struct cmd_data *);
+void a8_wake_timer_handler(struct cmd_data *);
+void a8_ds_count_config_handler(struct cmd_data *);
+void a8_mailbox_config_handler(struct cmd_data *);
 
+void pm_nvic_init(void);
+void pm_nvic_flush(void);
+void pm_entry_begin(void);
+void pm_entry_end(void);
 void generic_wake_handler(int);
 void a8_wake_rtc_handler(void);
 void a8_wake_ds0_handler(void);
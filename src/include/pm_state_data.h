@@ -17,6 +17,7 @@ union state_data;
 
 extern union state_data rtc_mode_data;
 extern union state_data standby_data;
+extern union state_data standby_ret_data;
 extern union state_data ds0_data;
 extern union state_data ds0_data_hs;
 extern union state_data ds1_data;
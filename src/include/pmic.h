@@ -0,0 +1,56 @@
+/*
+ * AM33XX-CM3 firmware
+ *
+ * Cortex-M3 (CM3) firmware for power management on Texas Instruments' AM33XX series of SoCs
+ *
+ * Copyright (C) 2011 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  This software is licensed under the  standard terms and conditions in the Texas Instruments  Incorporated
+ *  Technology and Software Publicly Available Software License Agreement , a copy of which is included in the
+ *  software download.
+*/
+
+#ifndef __PMIC_H__
+#define __PMIC_H__
+
+#include <stddef.h>
+
+enum vdd_id {
+	VDD_MPU,
+	VDD_CORE,
+
+	VDD_COUNT,
+};
+
+/*
+ * Description of one PMIC rail, filled in by the A8 in DMEM and passed
+ * along with CMD_ID_PMIC_CONFIG. The rail is assumed to be programmed
+ * by writing a linear selector to a single register.
+ */
+struct pmic_vdd_cfg {
+	unsigned short speed_khz;	/* I2C0 bus speed */
+	unsigned char slave_addr;	/* 7-bit PMIC address */
+	unsigned char vsel_reg;		/* Voltage select register */
+	unsigned char vsel_min;		/* Lowest valid selector */
+	unsigned char vsel_max;		/* Highest valid selector */
+	unsigned char vsel;		/* Selector currently programmed */
+	unsigned char reserved;
+	unsigned int min_uv;		/* Voltage at vsel_min */
+	unsigned int step_uv;		/* Voltage step per selector */
+	unsigned int slew_uv;		/* Ramp rate in uV/us */
+};
+
+int pmic_configure(const struct pmic_vdd_cfg *cfg);
+bool pmic_vdd_valid(enum vdd_id id);
+
+unsigned int pmic_vdd_get_vsel(enum vdd_id id);
+int pmic_vdd_set_vsel(enum vdd_id id, unsigned int vsel);
+
+unsigned int pmic_uv_to_vsel(enum vdd_id id, unsigned int uv);
+unsigned int pmic_vsel_to_uv(enum vdd_id id, unsigned int vsel);
+
+int pmic_vdd_lower(enum vdd_id id, unsigned int uv);
+bool pmic_vdd_lowered(enum vdd_id id);
+int pmic_vdd_restore(enum vdd_id id);
+
+#endif
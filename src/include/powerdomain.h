@@ -16,12 +16,16 @@
 enum powerdomain_id {
 	PD_MPU,
 	PD_PER,
+
+	PD_COUNT,
 };
 
 #define PD_ON                   0x3
 #define PD_RET                  0x1
 #define PD_OFF                  0x0
 
+#define PD_TRANSITION_TIMEOUT	10000
+
 #define MEM_BANK_RET_ST_RET     0x1
 #define MEM_BANK_RET_ST_OFF     0x0
 
@@ -74,10 +78,12 @@ void powerdomain_init(void);
 unsigned int pd_state_change(unsigned int, enum powerdomain_id id);
 void pd_state_restore(enum powerdomain_id id);
 unsigned int pd_read_state(enum powerdomain_id pd);
+int pd_wait_for_transition(enum powerdomain_id pd);
 
 unsigned int get_pd_per_stctrl_val(struct deep_sleep_data *data);
 unsigned int get_pd_mpu_stctrl_val(struct deep_sleep_data *data);
 
+int verify_pd_transition(enum powerdomain_id pd);
 int verify_pd_transitions(void);
 
 #endif
@@ -56,13 +56,22 @@ int disable_master_oscillator(void);
 int enable_master_oscillator(void);
 
 void configure_deepsleep_count(int ds_count);
+unsigned int ds_count_select(unsigned int requested);
+void ds_count_tune(void);
+void ds_count_publish(void);
+unsigned int ds_count_us(void);
+int ds_count_configure(unsigned int guard);
 void configure_wake_sources(int wake_sources);
 void clear_wake_sources(void);
 
 void ds_save(void);
 void ds_restore(void);
+void ds_restore_critical(unsigned int defer_mask);
+void ds_restore_deferred(void);
 
+int pm_i2c_write(const unsigned char *);
 int a8_i2c_sleep_handler(unsigned short);
+int a8_i2c_sleep_cached_handler(unsigned short);
 int a8_i2c_wake_handler(unsigned short);
 
 void prcm_enable_isolation(void);
@@ -0,0 +1,48 @@
+/*
+ * AM33XX-CM3 firmware
+ *
+ * Cortex-M3 (CM3) firmware for power management on Texas Instruments' AM33XX series of SoCs
+ *
+ * Copyright (C) 2011 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  This software is licensed under the  standard terms and conditions in the Texas Instruments  Incorporated
+ *  Technology and Software Publicly Available Software License Agreement , a copy of which is included in the
+ *  software download.
+*/
+
+
+#ifndef __PROMOTE_H__
+#define __PROMOTE_H__
+
+#include <stddef.h>
+
+struct deep_sleep_data;
+
+/*
+ * Steps the CM3 takes on its own while the MPU stays in cpuidle, one
+ * per idle threshold. Everything done gets journaled and is undone on
+ * wake like the rest of the entry. DDR stays live in cpuidle, so the
+ * A8 must only allow the levels that are safe for its running system:
+ * PROMOTE_PLLS bypasses the display DPLL and PROMOTE_MOSC needs the
+ * EMIF to put DDR in self-refresh on its own.
+ */
+enum promote_level {
+	PROMOTE_NONE,
+	PROMOTE_CLKDMS,		/* Deferred peripheral clockdomains to sleep */
+	PROMOTE_PER_RET,	/* PD_PER to retention, memories retained */
+	PROMOTE_PLLS,		/* Display DPLL to bypass */
+	PROMOTE_MOSC,		/* Master oscillator off */
+
+	PROMOTE_COUNT,
+};
+
+/* Longest idle threshold, keeps the 32K tick count from overflowing */
+#define PROMOTE_MAX_MS		60000
+
+int promote_configure(unsigned int ms, unsigned int max_level);
+void promote_start(struct deep_sleep_data *data);
+void promote_stop(void);
+enum promote_level promote_reached(void);
+void promote_irq_handler(void);
+
+#endif
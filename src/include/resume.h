@@ -0,0 +1,33 @@
+/*
+ * AM33XX-CM3 firmware
+ *
+ * Cortex-M3 (CM3) firmware for power management on Texas Instruments' AM33XX series of SoCs
+ *
+ * Copyright (C) 2011 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  This software is licensed under the  standard terms and conditions in the Texas Instruments  Incorporated
+ *  Technology and Software Publicly Available Software License Agreement , a copy of which is included in the
+ *  software download.
+*/
+
+#ifndef __RESUME_H__
+#define __RESUME_H__
+
+enum resume_stage_id {
+	RESUME_LDO_CORE,
+	RESUME_PLL_PON,
+	RESUME_PLL_PGOOD,
+	RESUME_PLL_RELEASE,
+
+	RESUME_STAGE_COUNT,
+};
+
+#define RESUME_STAGE(id)	(1 << (id))
+
+#define RESUME_PLLS		(RESUME_STAGE(RESUME_PLL_PON) | \
+				 RESUME_STAGE(RESUME_PLL_PGOOD) | \
+				 RESUME_STAGE(RESUME_PLL_RELEASE))
+
+void resume_stages_run(unsigned int stages);
+
+#endif
@@ -37,6 +37,8 @@
 
 #define RTC_KICK0		0x6c
 #define RTC_KICK1		0x70
+#define RTC_KICK0_VAL		0x83e70b13
+#define RTC_KICK1_VAL		0x95a4f1e0
 #define RTC_SYSCONFIG		0x78
 #define RTC_IRQWAKEEN_0		0x7c
 
@@ -64,12 +66,49 @@
 #define RTC_STATUS_RUN             (1<<1)
 #define RTC_STATUS_BUSY            (1<<0)
 
+/* RTC_PMIC_REG bit fields: */
+#define RTC_PMIC_PWR_ENABLE_EN     (1<<16)
+
+/*
+ * The scratch registers at 0x60-0x68 belong to the kernel: rtc-omap
+ * exposes them as nvmem, and the RTC+DDR resume vector and boot magic
+ * are its to write. The CM3 leaves them alone.
+ */
+
 /* RTC_INTERRUPTS_REG bit fields: */
 #define RTC_INTERRUPTS_IT_ALARM    (1<<3)
 #define RTC_INTERRUPTS_IT_TIMER    (1<<2)
 
+/* RTC_IRQWAKEEN_0 bit fields: */
+#define RTC_IRQWAKEEN_ALARM        (1<<1)
+
+/*
+ * Binary calendar time as kept in BCD by the RTC. The RTC only counts
+ * two digit years, they are taken to be 2000 to 2099.
+ */
+struct rtc_time {
+	unsigned char sec;
+	unsigned char min;
+	unsigned char hour;
+	unsigned char day;		/* 1 to 31 */
+	unsigned char month;		/* 1 to 12 */
+	unsigned char year;		/* 0 to 99 */
+};
+
+/* Latest time the RTC can hold, in seconds since 2000-01-01 00:00:00 */
+#define RTC_SECS_MAX		3155759999u
+
 int rtc_enable_check(void);
 unsigned int rtc_reg_read(int);
 void rtc_reg_write(unsigned int, int);
 
+void rtc_time_read(int reg, struct rtc_time *tm);
+void rtc_time_write(int reg, const struct rtc_time *tm);
+unsigned int rtc_time_to_secs(const struct rtc_time *tm);
+void rtc_secs_to_time(unsigned int secs, struct rtc_time *tm);
+int rtc_time_add(struct rtc_time *tm, unsigned int secs);
+int rtc_alarm_set(unsigned int secs, bool absolute);
+bool rtc_alarm_busy(void);
+void rtc_alarm_clear(void);
+
 #endif
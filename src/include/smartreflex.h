@@ -0,0 +1,44 @@
+/*
+ * AM33XX-CM3 firmware
+ *
+ * Cortex-M3 (CM3) firmware for power management on Texas Instruments' AM33XX series of SoCs
+ *
+ * Copyright (C) 2011 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  This software is licensed under the  standard terms and conditions in the Texas Instruments  Incorporated
+ *  Technology and Software Publicly Available Software License Agreement , a copy of which is included in the
+ *  software download.
+*/
+
+#ifndef __SMARTREFLEX_H__
+#define __SMARTREFLEX_H__
+
+#include <pmic.h>
+
+/*
+ * Per VDD SmartReflex parameters for the current OPP, filled in by the
+ * A8 in DMEM and passed along with CMD_ID_AVS. The A8 has to re-issue
+ * CMD_ID_AVS after every OPP change.
+ *
+ * While AVS is running the CM3 owns I2C0, the A8 must not access the
+ * PMIC on its own.
+ */
+struct sr_cfg {
+	unsigned int nvalue;		/* NVALUERECIPROCAL from efuse */
+	unsigned char errweight;
+	unsigned char accumdata;	/* Samples averaged per interrupt */
+	signed char err_min;		/* Step up below this raw AVGERROR */
+	signed char err_max;		/* Step down above this raw AVGERROR */
+	unsigned char vsel_nom;		/* PMIC selector of the OPP, never exceeded */
+	unsigned char vsel_floor;	/* Never step below this selector */
+	unsigned char reserved[2];
+};
+
+int sr_enable(enum vdd_id id, const struct sr_cfg *cfg);
+void sr_disable(enum vdd_id id);
+void sr_reset(void);
+void sr_suspend(void);
+void sr_resume(bool resync);
+void sr_irq_handler(enum vdd_id id);
+
+#endif
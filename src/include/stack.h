@@ -0,0 +1,25 @@
+/*
+ * AM33XX-CM3 firmware
+ *
+ * Cortex-M3 (CM3) firmware for power management on Texas Instruments' AM33XX series of SoCs
+ *
+ * Copyright (C) 2011 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  This software is licensed under the  standard terms and conditions in the Texas Instruments  Incorporated
+ *  Technology and Software Publicly Available Software License Agreement , a copy of which is included in the
+ *  software download.
+*/
+
+#ifndef __STACK_H__
+#define __STACK_H__
+
+/*
+ * The stack grows down from _end_stack into whatever DMEM .bss left
+ * over. Everything below the reset frame is painted with STACK_PAINT.
+ */
+#define STACK_PAINT	0xdeadbeef
+
+unsigned int stack_size(void);
+unsigned int stack_high_water(void);
+
+#endif
@@ -0,0 +1,26 @@
+/*
+ * AM33XX-CM3 firmware
+ *
+ * Cortex-M3 (CM3) firmware for power management on Texas Instruments' AM33XX series of SoCs
+ *
+ * Copyright (C) 2011 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  This software is licensed under the  standard terms and conditions in the Texas Instruments  Incorporated
+ *  Technology and Software Publicly Available Software License Agreement , a copy of which is included in the
+ *  software download.
+*/
+
+#ifndef __STATE_SELECT_H__
+#define __STATE_SELECT_H__
+
+#include <msg.h>
+
+void state_select_cmd(void);
+void state_entry_latency_update(enum cmd_ids id, unsigned int us);
+void state_exit_latency_update(enum cmd_ids id, unsigned int us);
+
+void state_idle_start(void);
+void state_idle_end(int wake_irq);
+bool state_idle_short(void);
+
+#endif
@@ -17,5 +17,7 @@ void a8_notify(int);
 void a8_m3_low_power_sync(int);
 void a8_m3_low_power_fast(int);
 void init_m3_state_machine(void);
+void timer_sync_start(void);
+void timer_sync(void);
 
 #endif
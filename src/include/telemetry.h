@@ -0,0 +1,100 @@
+/*
+ * AM33XX-CM3 firmware
+ *
+ * Cortex-M3 (CM3) firmware for power management on Texas Instruments' AM33XX series of SoCs
+ *
+ * Copyright (C) 2011 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  This software is licensed under the  standard terms and conditions in the Texas Instruments  Incorporated
+ *  Technology and Software Publicly Available Software License Agreement , a copy of which is included in the
+ *  software download.
+*/
+
+#ifndef __TELEMETRY_H__
+#define __TELEMETRY_H__
+
+#include <msg.h>
+#include <powerdomain.h>
+#include <wake_record.h>
+#include <crash.h>
+
+/*
+ * Statistics block at the start of DMEM (offset 0), see firmware.ld.
+ *
+ * The A8 reads seq, copies the block, then reads seq again. The copy
+ * is consistent if both values match and are even; an odd value means
+ * the CM3 was updating the block.
+ */
+#define TELEMETRY_MAGIC		0x4d4c4554	/* "TELM" */
+#define TELEMETRY_VERSION	8
+
+#define TELEMETRY_WAKE_IRQ_BASE	32
+#define TELEMETRY_WAKE_IRQS	32
+
+struct telemetry_cmd {
+	unsigned int entries;
+	unsigned int failures;		/* CMD_STAT_FAIL reported on wake */
+	unsigned int aborts;		/* Entries aborted by a wake event */
+	unsigned int entry_us_total;
+	unsigned int exit_us_total;
+	unsigned short entry_us_max;
+	unsigned short exit_us_max;
+};
+
+/*
+ * Timer based sync record, see timer_sync(). cmds identifies the
+ * mailbox command the record belongs to, done_us stays 0 until its
+ * status has been written.
+ */
+struct telemetry_sync {
+	unsigned int cmds;		/* Mailbox commands picked up */
+	unsigned short cmd_id;
+	unsigned short stat;		/* CMD_STAT_* once done */
+	unsigned int predicted_us;	/* Expected time until done */
+	unsigned int done_us;		/* Time it actually took */
+};
+
+struct telemetry {
+	unsigned int magic;
+	unsigned short version;
+	unsigned short size;
+	unsigned int seq;
+
+	/* failures of CMD_ID_INVALID count rejected commands */
+	struct telemetry_cmd cmds[CMD_ID_COUNT];
+	/* Wakeups per NVIC IRQ, from TELEMETRY_WAKE_IRQ_BASE */
+	unsigned int wake_irqs[TELEMETRY_WAKE_IRQS];
+	/* verify_pd_transitions() failures */
+	unsigned int pd_failures[PD_COUNT];
+	/* Wake interrupts taken after their wakeup was already handled */
+	unsigned int late_wakes;
+	/* cpuidle v2 entries that kept the MPU DPLL locked */
+	unsigned int idle_shallow;
+	/* Bytes between .bss and the top of DMEM, and the most ever used */
+	unsigned short stack_size;
+	unsigned short stack_max;
+	/* Last mailbox command */
+	struct telemetry_sync sync;
+	/* Details of the last wakeup */
+	struct wake_record wake;
+	/* Why the CM3 stopped, magic is 0 while it runs */
+	struct crash_record crash;
+};
+
+void telemetry_init(void);
+void telemetry_cmd_invalid(void);
+void telemetry_entry_start(enum cmd_ids id);
+void telemetry_entry_done(void);
+void telemetry_entry_abort(bool failed);
+void telemetry_exit_done(enum cmd_ids id, unsigned int us, bool failed);
+void telemetry_wake(int irq);
+void telemetry_wake_late(unsigned int irqs);
+void telemetry_pd_failure(enum powerdomain_id pd);
+void telemetry_idle_shallow(void);
+void telemetry_stack_update(void);
+void telemetry_sync_post(unsigned int cmd_id, unsigned int predicted_us);
+void telemetry_sync_done(unsigned int stat, unsigned int us);
+volatile struct crash_record *telemetry_crash_begin(void);
+void telemetry_crash_end(void);
+
+#endif
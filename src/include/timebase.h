@@ -0,0 +1,39 @@
+/*
+ * AM33XX-CM3 firmware
+ *
+ * Cortex-M3 (CM3) firmware for power management on Texas Instruments' AM33XX series of SoCs
+ *
+ * Copyright (C) 2011 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  This software is licensed under the  standard terms and conditions in the Texas Instruments  Incorporated
+ *  Technology and Software Publicly Available Software License Agreement , a copy of which is included in the
+ *  software download.
+*/
+
+
+#ifndef __TIMEBASE_H__
+#define __TIMEBASE_H__
+
+#include <stddef.h>
+
+/*
+ * Monotonic 64 bit time. The 32K counter keeps running through every
+ * low power state, so it is the reference; the DWT cycle counter gives
+ * the resolution in between while the CM3 runs. SysTick extends both
+ * 32 bit counters to 64 bits.
+ */
+
+/* 32K edges measured against the CM3 clock at init, a power of 2 */
+#define TIMEBASE_CAL_TICKS	512
+
+void timebase_init(void);
+void timebase_calibrate(void);
+void timebase_tick(void);
+
+unsigned long long timebase_ticks(void);
+unsigned long long timebase_cycles(void);
+unsigned long long timebase_us(void);
+unsigned int timebase_ticks_to_us(unsigned int ticks);
+unsigned int timebase_tick_hz(void);
+
+#endif
@@ -0,0 +1,44 @@
+/*
+ * AM33XX-CM3 firmware
+ *
+ * Cortex-M3 (CM3) firmware for power management on Texas Instruments' AM33XX series of SoCs
+ *
+ * Copyright (C) 2011 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  This software is licensed under the  standard terms and conditions in the Texas Instruments  Incorporated
+ *  Technology and Software Publicly Available Software License Agreement , a copy of which is included in the
+ *  software download.
+*/
+
+#ifndef __WAKE_RECORD_H__
+#define __WAKE_RECORD_H__
+
+/* wake_record.valid bits, set when the peripheral could be read */
+#define WAKE_REC_GPIO0		(1 << 0)
+#define WAKE_REC_RTC		(1 << 1)
+#define WAKE_REC_UART0		(1 << 2)
+
+/*
+ * Snapshot taken as the CM3 wakes, before the NVIC gets flushed. The
+ * peripheral fields are raw register values so that the A8 can skip
+ * probing its wake capable drivers:
+ *  gpio0:	pins with a latched event and wakeup enabled
+ *  rtc:	RTC_STATUS_REG (alarm, alarm2 and periodic timer events)
+ *  uart0:	UART SSR, bit 1 is the RX/CTS wakeup status
+ */
+struct wake_record {
+	unsigned int count;		/* Bumped on every wakeup */
+	unsigned char irq;		/* NVIC line that woke the CM3 */
+	unsigned char valid;
+	unsigned short reserved;
+	unsigned int pending[2];	/* NVIC lines 0-63 pending at wake */
+	unsigned int gpio0;
+	unsigned int rtc;
+	unsigned int uart0;
+	unsigned int late;		/* Wake lines 32-63 that fired after
+					   the wakeup was claimed */
+};
+
+void wake_record_capture(struct wake_record *rec, int irq);
+
+#endif
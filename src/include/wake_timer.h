@@ -0,0 +1,39 @@
+/*
+ * AM33XX-CM3 firmware
+ *
+ * Cortex-M3 (CM3) firmware for power management on Texas Instruments' AM33XX series of SoCs
+ *
+ * Copyright (C) 2011 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  This software is licensed under the  standard terms and conditions in the Texas Instruments  Incorporated
+ *  Technology and Software Publicly Available Software License Agreement , a copy of which is included in the
+ *  software download.
+*/
+
+
+#ifndef __WAKE_TIMER_H__
+#define __WAKE_TIMER_H__
+
+#include <stddef.h>
+
+/*
+ * Wake deadlines queued by the A8, in DMTIMER1_1MS ticks. The kernel
+ * has to keep DMTIMER1_1MS running, usually as its clocksource. The CM3
+ * never changes its count, it only uses the match register.
+ */
+#define WAKE_TIMER_QUEUE_LEN	8
+
+/*
+ * DMTIMER1_1MS runs from a 32K clock, deadlines further out may use the
+ * RTC if the A8 allows it. From RC32K it runs at the calibrated timebase
+ * rate instead.
+ */
+#define WAKE_TIMER_HZ		32768
+
+int wake_timer_add(unsigned int deadline, unsigned int tolerance_ms,
+						unsigned int id, bool rtc);
+void wake_timer_cancel(unsigned int id);
+void wake_timer_arm(void);
+void wake_timer_disarm(void);
+
+#endif
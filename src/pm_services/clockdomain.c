@@ -15,21 +15,25 @@
 #include <clockdomain_335x.h>
 #include <clockdomain_43xx.h>
 #include <io.h>
+#include <journal.h>
 
 #define CLKDM_SLEEP	0x1
 #define CLKDM_WAKE	0x2
 
 static const unsigned int *clkdms;
 static const enum clkdm_id *sleep_clkdms;
+static const enum clkdm_id *deferred_clkdms;
 
 void clockdomain_init(void)
 {
 	if (soc_id == AM335X_SOC_ID) {
 		clkdms = am335x_clkdms;
 		sleep_clkdms = am335x_sleep_clkdms;
+		deferred_clkdms = am335x_deferred_clkdms;
 	} else if (soc_id == AM43XX_SOC_ID) {
 		clkdms = am43xx_clkdms;
 		sleep_clkdms = am43xx_sleep_clkdms;
+		deferred_clkdms = am43xx_deferred_clkdms;
 	}
 }
 
@@ -88,8 +92,22 @@ bool clkdm_active(enum clkdm_id id)
 	return var == DEFAULT_CLKTRCTRL_WAKE;
 }
 
+bool clkdm_sleeping(enum clkdm_id id)
+{
+	unsigned int var;
+
+	if (!clkdms[id])
+		return false;
+
+	var = __raw_readl(clkdms[id]);
+	var &= DEFAULT_CLKTRCTRL_MASK;
+
+	return var == DEFAULT_CLKTRCTRL_SLEEP;
+}
+
 void clkdm_sleep(enum clkdm_id id)
 {
+	journal_push(JOURNAL_CLKDM, id);
 	_clkdm_sleep(clkdms[id]);
 }
 
@@ -100,6 +118,7 @@ void clkdm_wake(enum clkdm_id id)
 
 void clkdms_sleep(void)
 {
+	journal_push(JOURNAL_CLKDMS, 0);
 	clkdms_state_change(CLKDM_SLEEP, sleep_clkdms);
 }
 
@@ -107,3 +126,39 @@ void clkdms_wake(void)
 {
 	clkdms_state_change(CLKDM_WAKE, sleep_clkdms);
 }
+
+static bool clkdm_deferred(enum clkdm_id id)
+{
+	int i;
+
+	for (i = 0; deferred_clkdms[i] != CLKDM_END; i++)
+		if (deferred_clkdms[i] == id)
+			return true;
+
+	return false;
+}
+
+/* Wake the sleep clockdomains the MPU depends on to resume */
+void clkdms_wake_critical(void)
+{
+	int i;
+
+	for (i = 0; sleep_clkdms[i] != CLKDM_END; i++)
+		if (!clkdm_deferred(sleep_clkdms[i]))
+			clkdm_wake(sleep_clkdms[i]);
+}
+
+/* Peripheral clockdomains the MPU and DDR do not depend on */
+void clkdms_sleep_deferred(void)
+{
+	int i;
+
+	for (i = 0; deferred_clkdms[i] != CLKDM_END; i++)
+		clkdm_sleep(deferred_clkdms[i]);
+}
+
+/* Wake what clkdms_wake_critical() left behind */
+void clkdms_wake_deferred(void)
+{
+	clkdms_state_change(CLKDM_WAKE, deferred_clkdms);
+}
@@ -44,3 +44,12 @@ const enum clkdm_id am335x_sleep_clkdms[] = {
 
 	CLKDM_END,
 };
+
+/* Not needed by the MPU to resume, woken after it has been released */
+const enum clkdm_id am335x_deferred_clkdms[] = {
+	CLKDM_ICSS,
+	CLKDM_CPSW,
+	CLKDM_LCDC,
+
+	CLKDM_END,
+};
@@ -43,3 +43,13 @@ const enum clkdm_id am43xx_sleep_clkdms[] = {
 
 	CLKDM_END,
 };
+
+/* Not needed by the MPU to resume, woken after it has been released */
+const enum clkdm_id am43xx_deferred_clkdms[] = {
+	CLKDM_DSS,
+	CLKDM_LCDC,
+	CLKDM_ICSS,
+	CLKDM_CPSW,
+
+	CLKDM_END,
+};
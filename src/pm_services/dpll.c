@@ -16,6 +16,7 @@
 #include <dpll.h>
 #include <dpll_335x.h>
 #include <dpll_43xx.h>
+#include <journal.h>
 
 /* DPLL CLOCKMODE register */
 #define DPLL_EN_MASK					(0x7 << 0)
@@ -24,10 +25,33 @@
 #define DPLL_DIV_PER_SHIFT				(0)
 #define DPLL_DIV_PER_MASK				(0xff)
 
+/* DPLL CLKSEL register */
+#define DPLL_MULT_SHIFT					(8)
+#define DPLL_MULT_MASK					(0x7ff << 8)
+#define DPLL_DIV_SHIFT					(0)
+#define DPLL_DIV_MASK					(0x7f)
+
+/* DPLL M2 divider register */
+#define DPLL_DIV_M2_MASK				(0x1f)
+
+/* DPLL M4 divider register */
+#define DPLL_DIV_M4_MASK				(0x1f)
+
+/* DPLL IDLEST register */
+#define DPLL_ST_DPLL_CLK				(1 << 0)
+
+/* Register snapshot taken when a DPLL is put in bypass */
+struct dpll_state {
+	unsigned int clkmode;
+	unsigned int clksel;
+	unsigned int div_m2;
+	bool locked;
+};
+
 static const struct dpll_regs *dpll_regs;
 static const enum dpll_id *power_down_plls;
 
-static unsigned int pll_mode[DPLL_COUNT];
+static struct dpll_state dpll_states[DPLL_COUNT];
 
 /* DPLL power-down Sequence PG 2.x */
 static void dpll_power_down(enum dpll_id dpll)
@@ -70,28 +94,24 @@ static void dpll_power_down(enum dpll_id dpll)
 			dpll_regs[dpll].ponout_status_bit));
 }
 
-/* DPLL Power-up Sequence */
-static void dpll_power_up(enum dpll_id dpll)
+static void dpll_pwr_sw_set(enum dpll_id dpll, unsigned int bits)
 {
 	unsigned int var;
 
-	/* PONIN is asserted high */
 	var = __raw_readl(dpll_regs[dpll].dpll_pwr_sw_ctrl_reg);
-	var |= dpll_regs[dpll].ponin_bit;
+	var |= bits;
 	__raw_writel(var, dpll_regs[dpll].dpll_pwr_sw_ctrl_reg);
+}
 
-	/* Poll for PONOUT to become high  */
-	while (!(__raw_readl(dpll_regs[dpll].dpll_pwr_sw_status_reg) &
-				dpll_regs[dpll].ponout_status_bit));
-
-	/* PGOODIN is asserted high */
-	var = __raw_readl(dpll_regs[dpll].dpll_pwr_sw_ctrl_reg);
-	var |= dpll_regs[dpll].pgoodin_bit;
-	__raw_writel(var, dpll_regs[dpll].dpll_pwr_sw_ctrl_reg);
+static bool dpll_pwr_sw_status(enum dpll_id dpll, unsigned int bits)
+{
+	return (__raw_readl(dpll_regs[dpll].dpll_pwr_sw_status_reg) & bits) == bits;
+}
 
-	/* Poll for PGOODOUT to become high */
-	while (!(__raw_readl(dpll_regs[dpll].dpll_pwr_sw_status_reg) &
-				dpll_regs[dpll].pgoodout_status_bit));
+/* Last step of the DPLL power-up sequence, once PGOODOUT is high */
+static void dpll_power_up_finish(enum dpll_id dpll)
+{
+	unsigned int var;
 
 	/* De-assert DPLL RESET to 0 */
 	var = __raw_readl(dpll_regs[dpll].dpll_pwr_sw_ctrl_reg);
@@ -114,41 +134,220 @@ static void dpll_power_up(enum dpll_id dpll)
 	__raw_writel(var, dpll_regs[dpll].dpll_pwr_sw_ctrl_reg);
 }
 
+/*
+ * DPLL power-up sequence PG 2.x, split in phases. Every phase is applied
+ * to all DPLLs at once so their analog settling times overlap instead
+ * of adding up.
+ */
+
+/* PONIN is asserted high */
+void plls_pon_start(void)
+{
+	int i;
+
+	for (i = 0; power_down_plls && power_down_plls[i] != DPLL_END; i++)
+		dpll_pwr_sw_set(power_down_plls[i],
+				dpll_regs[power_down_plls[i]].ponin_bit);
+}
+
+/* PONOUT is high */
+bool plls_pon_done(void)
+{
+	int i;
+
+	for (i = 0; power_down_plls && power_down_plls[i] != DPLL_END; i++)
+		if (!dpll_pwr_sw_status(power_down_plls[i],
+			dpll_regs[power_down_plls[i]].ponout_status_bit))
+			return false;
+
+	return true;
+}
+
+/* PGOODIN is asserted high */
+void plls_pgood_start(void)
+{
+	int i;
+
+	for (i = 0; power_down_plls && power_down_plls[i] != DPLL_END; i++)
+		dpll_pwr_sw_set(power_down_plls[i],
+				dpll_regs[power_down_plls[i]].pgoodin_bit);
+}
+
+/* PGOODOUT is high */
+bool plls_pgood_done(void)
+{
+	int i;
+
+	for (i = 0; power_down_plls && power_down_plls[i] != DPLL_END; i++)
+		if (!dpll_pwr_sw_status(power_down_plls[i],
+			dpll_regs[power_down_plls[i]].pgoodout_status_bit))
+			return false;
+
+	return true;
+}
+
+void plls_power_up_finish(void)
+{
+	int i;
+
+	for (i = 0; power_down_plls && power_down_plls[i] != DPLL_END; i++)
+		dpll_power_up_finish(power_down_plls[i]);
+}
+
 /* DPLL retention update for PG 2.0 */
 void plls_power_down(void)
 {
 	int i;
 
+	journal_push(JOURNAL_PLLS, 0);
+
 	for (i = 0; power_down_plls && power_down_plls[i] != DPLL_END; i++)
 		dpll_power_down(power_down_plls[i]);
 }
 
 /* DPLL retention update for PG 2.x */
 void plls_power_up(void)
+{
+	plls_pon_start();
+	while (!plls_pon_done());
+
+	plls_pgood_start();
+	while (!plls_pgood_done());
+
+	plls_power_up_finish();
+}
+
+bool dpll_is_locked(enum dpll_id dpll)
+{
+	return __raw_readl(dpll_regs[dpll].idlest_reg) & DPLL_ST_DPLL_CLK;
+}
+
+/*
+ * Snapshot the mode and divider setup of a DPLL. Only DPLLs that are
+ * locked at this point get bypassed, and therefore relocked later on.
+ */
+static void dpll_save(enum dpll_id dpll)
+{
+	struct dpll_state *state = &dpll_states[dpll];
+
+	state->clkmode = __raw_readl(dpll_regs[dpll].clkmode_reg);
+	state->clksel = __raw_readl(dpll_regs[dpll].clksel_reg);
+	if (dpll_regs[dpll].div_m2_reg)
+		state->div_m2 = __raw_readl(dpll_regs[dpll].div_m2_reg) &
+							DPLL_DIV_M2_MASK;
+
+	state->locked = (state->clkmode & DPLL_EN_MASK) == DPLL_LOCK_MODE;
+}
+
+/* Only write back the dividers if something changed them meanwhile */
+static void dpll_restore_dividers(enum dpll_id dpll)
+{
+	struct dpll_state *state = &dpll_states[dpll];
+	unsigned int val;
+
+	if (__raw_readl(dpll_regs[dpll].clksel_reg) != state->clksel)
+		__raw_writel(state->clksel, dpll_regs[dpll].clksel_reg);
+
+	if (dpll_regs[dpll].div_m2_reg) {
+		val = __raw_readl(dpll_regs[dpll].div_m2_reg);
+		if ((val & DPLL_DIV_M2_MASK) != state->div_m2)
+			__raw_writel(var_mod(val, DPLL_DIV_M2_MASK,
+				state->div_m2), dpll_regs[dpll].div_m2_reg);
+	}
+}
+
+static void dpll_enter_bypass(enum dpll_id dpll)
+{
+	__raw_writel(((dpll_states[dpll].clkmode & ~DPLL_EN_MASK) |
+			DPLL_LP_BYP_MODE), dpll_regs[dpll].clkmode_reg);
+}
+
+static void dpll_relock(enum dpll_id dpll)
+{
+	dpll_restore_dividers(dpll);
+	__raw_writel(dpll_states[dpll].clkmode, dpll_regs[dpll].clkmode_reg);
+}
+
+/*
+ * Wait until every DPLL in the mask has reached the requested state.
+ * All the DPLLs transition in parallel, so poll them together instead
+ * of waiting on each of them in turn.
+ */
+static void dplls_wait(unsigned int pending, bool locked)
 {
 	int i;
 
-	for (i = 0; power_down_plls && power_down_plls[i] != DPLL_END; i++)
-		dpll_power_up(power_down_plls[i]);
+	while (pending) {
+		for (i = 0; i < DPLL_COUNT; i++)
+			if ((pending & (1 << i)) &&
+			    dpll_is_locked(i) == locked)
+				pending &= ~(1 << i);
+	}
 }
 
 void pll_bypass(enum dpll_id dpll)
 {
-	pll_mode[dpll] = __raw_readl(dpll_regs[dpll].clkmode_reg);
-	__raw_writel(((pll_mode[dpll] & ~DPLL_EN_MASK) |
-			DPLL_LP_BYP_MODE), dpll_regs[dpll].clkmode_reg);
+	dpll_save(dpll);
+	if (!dpll_states[dpll].locked)
+		return;
+
+	journal_push(JOURNAL_PLL_BYPASS, dpll);
+	dpll_enter_bypass(dpll);
 
 	/* Wait for DPLL to enter bypass mode */
-	while (__raw_readl(dpll_regs[dpll].idlest_reg));
+	dplls_wait(1 << dpll, false);
 }
 
 void pll_lock(enum dpll_id dpll)
 {
-	__raw_writel(pll_mode[dpll], dpll_regs[dpll].clkmode_reg);
+	if (!dpll_states[dpll].locked)
+		return;
+
+	dpll_relock(dpll);
+
+	/* Make sure DPLL Clock is out of Bypass */
+	dplls_wait(1 << dpll, true);
+}
+
+/* Bypass all the currently locked DPLLs in the list */
+void plls_bypass(const enum dpll_id *ids)
+{
+	unsigned int pending = 0;
+	int i;
+
+	for (i = 0; ids[i] != DPLL_END; i++) {
+		dpll_save(ids[i]);
+		if (!dpll_states[ids[i]].locked)
+			continue;
+
+		dpll_enter_bypass(ids[i]);
+		pending |= 1 << ids[i];
+	}
+
+	dplls_wait(pending, false);
+}
+
+/*
+ * Relock the DPLLs bypassed by plls_bypass(), walking the list
+ * backwards. DPLLs that were not locked before are left alone.
+ */
+void plls_lock(const enum dpll_id *ids)
+{
+	unsigned int pending = 0;
+	int i;
+
+	for (i = 0; ids[i] != DPLL_END; i++)
+		;
+
+	for (i--; i >= 0; i--) {
+		if (!dpll_states[ids[i]].locked)
+			continue;
 
-	if ((pll_mode[dpll] & 0x7) == 0x7)
-		/* Make sure DPLL Clock is out of Bypass */
-		while (!(__raw_readl(dpll_regs[dpll].idlest_reg)));
+		dpll_relock(ids[i]);
+		pending |= 1 << ids[i];
+	}
+
+	dplls_wait(pending, true);
 }
 
 unsigned int dpll_get_div(enum dpll_id dpll)
@@ -167,7 +366,7 @@ void dpll_reset(void)
 	int i = 0;
 
 	for (i = 0; i < DPLL_COUNT; i++)
-		pll_mode[i] = 0;
+		dpll_states[i].locked = false;
 }
 
 void dpll_init(void)
@@ -198,3 +397,30 @@ unsigned int get_master_xtal_khz(void)
 	}
 	return xtal_freqs[index];
 }
+
+/*
+ * The CM3 runs from CORE_CLKOUTM4 / 2. The locked CORE DPLL gives
+ * CLKDCOLDO = 2 * M / (N + 1) * CLKINP, which M4 divides down, so the
+ * CM3 runs at 100 MHz at CORE OPP100 and 50 MHz at OPP50. 0 if the
+ * CORE DPLL is not locked.
+ */
+unsigned int cm3_clk_khz(void)
+{
+	const struct dpll_regs *regs = &dpll_regs[DPLL_CORE];
+	unsigned int clksel;
+	unsigned int m;
+	unsigned int n;
+	unsigned int m4;
+
+	if (!dpll_is_locked(DPLL_CORE))
+		return 0;
+
+	clksel = __raw_readl(regs->clksel_reg);
+	m = (clksel & DPLL_MULT_MASK) >> DPLL_MULT_SHIFT;
+	n = (clksel & DPLL_DIV_MASK) >> DPLL_DIV_SHIFT;
+	m4 = __raw_readl(regs->div_m4_reg) & DPLL_DIV_M4_MASK;
+	if (!m4)
+		return 0;
+
+	return get_master_xtal_khz() * m / ((n + 1) * m4);
+}
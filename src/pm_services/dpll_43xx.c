@@ -31,6 +31,7 @@ const struct dpll_regs am43xx_dpll_regs[DPLL_COUNT] = {
 		.clkmode_reg		= AM43XX_CM_CLKMODE_DPLL_PER,
 		.idlest_reg		= AM43XX_CM_IDLEST_DPLL_PER,
 		.clksel_reg		= AM43XX_CM_CLKSEL_DPLL_PER,
+		.div_m2_reg		= AM43XX_CM_DIV_M2_DPLL_PER,
 	},
 	[DPLL_DISP] = {
 		.dpll_pwr_sw_ctrl_reg	= DPLL_PWR_SW_CTRL,
@@ -47,6 +48,7 @@ const struct dpll_regs am43xx_dpll_regs[DPLL_COUNT] = {
 		.clkmode_reg		= AM43XX_CM_CLKMODE_DPLL_DISP,
 		.idlest_reg		= AM43XX_CM_IDLEST_DPLL_DISP,
 		.clksel_reg		= AM43XX_CM_CLKSEL_DPLL_DISP,
+		.div_m2_reg		= AM43XX_CM_DIV_M2_DPLL_DISP,
 	},
 	[DPLL_DDR] = {
 		.dpll_pwr_sw_ctrl_reg	= DPLL_PWR_SW_CTRL,
@@ -63,16 +65,19 @@ const struct dpll_regs am43xx_dpll_regs[DPLL_COUNT] = {
 		.clkmode_reg		= AM43XX_CM_CLKMODE_DPLL_DDR,
 		.idlest_reg		= AM43XX_CM_IDLEST_DPLL_DDR,
 		.clksel_reg		= AM43XX_CM_CLKSEL_DPLL_DDR,
+		.div_m2_reg		= AM43XX_CM_DIV_M2_DPLL_DDR,
 	},
 	[DPLL_MPU] = {
 		.clkmode_reg		= AM43XX_CM_CLKMODE_DPLL_MPU,
 		.idlest_reg		= AM43XX_CM_IDLEST_DPLL_MPU,
 		.clksel_reg		= AM43XX_CM_CLKSEL_DPLL_MPU,
+		.div_m2_reg		= AM43XX_CM_DIV_M2_DPLL_MPU,
 	},
 	[DPLL_CORE] = {
 		.clkmode_reg		= AM43XX_CM_CLKMODE_DPLL_CORE,
 		.idlest_reg		= AM43XX_CM_IDLEST_DPLL_CORE,
 		.clksel_reg		= AM43XX_CM_CLKSEL_DPLL_CORE,
+		.div_m4_reg		= AM43XX_CM_DIV_M4_DPLL_CORE,
 	},
 };
 
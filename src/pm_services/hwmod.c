@@ -15,6 +15,7 @@
 #include <hwmod.h>
 #include <hwmod_335x.h>
 #include <hwmod_43xx.h>
+#include <journal.h>
 
 #define HWMOD_DISABLE	0x0
 #define HWMOD_ENABLE	0x2
@@ -91,6 +92,8 @@ void hwmod_enable(enum hwmod_id id)
 
 void hwmod_disable(enum hwmod_id id)
 {
+	if (_hwmod_is_enabled(hwmods[id]))
+		journal_push(JOURNAL_HWMOD, id);
 	_hwmod_disable(hwmods[id]);
 }
 
@@ -107,6 +110,7 @@ bool hwmod_is_enabled(enum hwmod_id id)
 int essential_hwmods_disable(void)
 {
 	/* Disable only the bare essential hwmods */
+	journal_push(JOURNAL_ESSENTIAL_HWMODS, 0);
 	hwmods_state_change(HWMOD_DISABLE, essential_hwmods);
 
 	return 0;
@@ -122,6 +126,7 @@ int essential_hwmods_enable(void)
 
 int interconnect_hwmods_disable(void)
 {
+	journal_push(JOURNAL_INTERCONNECT, 0);
 	hwmods_state_change(HWMOD_DISABLE, interconnect_hwmods);
 
 	return 0;
@@ -26,8 +26,14 @@ const unsigned int am335x_hwmods[HWMOD_COUNT] = {
 	[HWMOD_L4FW]		= AM335X_CM_PER_L4FW_CLKCTRL,
 	[HWMOD_L4HS]		= AM335X_CM_PER_L4HS_CLKCTRL,
 	[HWMOD_L4LS]		= AM335X_CM_PER_L4LS_CLKCTRL,
+	[HWMOD_MAILBOX0]	= AM335X_CM_PER_MAILBOX0_CLKCTRL,
 	[HWMOD_MPU]		= AM335X_CM_MPU_MPU_CLKCTRL,
 	[HWMOD_OCMCRAM]		= AM335X_CM_PER_OCMCRAM_CLKCTRL,
+	[HWMOD_SMARTREFLEX0]	= AM335X_CM_WKUP_SMARTREFLEX0_CLKCTRL,
+	[HWMOD_SMARTREFLEX1]	= AM335X_CM_WKUP_SMARTREFLEX1_CLKCTRL,
+	[HWMOD_TIMER0]		= AM335X_CM_WKUP_TIMER0_CLKCTRL,
+	[HWMOD_TIMER1]		= AM335X_CM_WKUP_TIMER1_CLKCTRL,
+	[HWMOD_UART0]		= AM335X_CM_WKUP_UART0_CLKCTRL,
 };
 
 const enum hwmod_id am335x_essential_hwmods[] = {
@@ -26,10 +26,16 @@ const unsigned int am43xx_hwmods[HWMOD_COUNT] = {
 	[HWMOD_L4FW]		= AM43XX_CM_PER_L4FW_CLKCTRL,
 	[HWMOD_L4HS]		= AM43XX_CM_PER_L4HS_CLKCTRL,
 	[HWMOD_L4LS]		= AM43XX_CM_PER_L4LS_CLKCTRL,
+	[HWMOD_MAILBOX0]	= AM43XX_CM_PER_MAILBOX0_CLKCTRL,
 	[HWMOD_MPU]		= AM43XX_CM_MPU_MPU_CLKCTRL,
 	[HWMOD_OCMCRAM]		= AM43XX_CM_PER_OCMCRAM_CLKCTRL,
 	[HWMOD_OTFA_EMIF]	= AM43XX_CM_PER_OTFA_EMIF_CLKCTRL,
 	[HWMOD_OCPWP]		= AM43XX_CM_PER_OCPWP_CLKCTRL,
+	[HWMOD_SMARTREFLEX0]	= AM43XX_CM_WKUP_SMARTREFLEX0_CLKCTRL,
+	[HWMOD_SMARTREFLEX1]	= AM43XX_CM_WKUP_SMARTREFLEX1_CLKCTRL,
+	[HWMOD_TIMER0]		= AM43XX_CM_WKUP_TIMER0_CLKCTRL,
+	[HWMOD_TIMER1]		= AM43XX_CM_WKUP_TIMER1_CLKCTRL,
+	[HWMOD_UART0]		= AM43XX_CM_WKUP_UART0_CLKCTRL,
 };
 
 const enum hwmod_id am43xx_essential_hwmods[] = {
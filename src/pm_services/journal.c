@@ -0,0 +1,95 @@
+/*
+ * AM33XX-CM3 firmware
+ *
+ * Cortex-M3 (CM3) firmware for power management on Texas Instruments' AM33XX series of SoCs
+ *
+ * Copyright (C) 2011 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  This software is licensed under the  standard terms and conditions in the Texas Instruments  Incorporated
+ *  Technology and Software Publicly Available Software License Agreement , a copy of which is included in the
+ *  software download.
+*/
+
+#include <stddef.h>
+#include <journal.h>
+#include <crash.h>
+
+struct journal_rec {
+	unsigned char op;
+	unsigned char arg;
+};
+
+static struct journal_rec recs[JOURNAL_DEPTH];
+static int depth;
+static bool recording;
+static int held;
+
+void journal_open(void)
+{
+	depth = 0;
+	held = 0;
+	recording = true;
+}
+
+/* Record more state changes on top of those already in the journal */
+void journal_resume(void)
+{
+	recording = true;
+}
+
+/* Stop recording, the records stay around for the wake path */
+void journal_close(void)
+{
+	recording = false;
+}
+
+/*
+ * Composite operations (ds_save(), PMIC accesses) undo their inner
+ * primitives themselves and hold the journal around them.
+ */
+void journal_hold(void)
+{
+	held++;
+}
+
+void journal_release(void)
+{
+	held--;
+}
+
+void journal_push(enum journal_op op, int arg)
+{
+	if (!recording || held)
+		return;
+
+	/* Never hit with the existing entry sequences */
+	if (depth == JOURNAL_DEPTH)
+		crash(CRASH_JOURNAL_FULL);
+
+	recs[depth].op = op;
+	recs[depth].arg = arg;
+	depth++;
+}
+
+bool journal_pop(enum journal_op *op, int *arg)
+{
+	if (!depth)
+		return false;
+
+	depth--;
+	*op = recs[depth].op;
+	*arg = recs[depth].arg;
+
+	return true;
+}
+
+bool journal_contains(enum journal_op op, int arg)
+{
+	int i;
+
+	for (i = 0; i < depth; i++)
+		if (recs[i].op == op && recs[i].arg == arg)
+			return true;
+
+	return false;
+}
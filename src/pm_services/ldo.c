@@ -15,6 +15,7 @@
 #include <ldo.h>
 #include <ldo_335x.h>
 #include <ldo_43xx.h>
+#include <journal.h>
 
 /* AM*_PRM_LDO_SRAM_CORE_CTRL register bit-fields */
 #define SRAM_IN_TRANSITION	(1 << 9)
@@ -24,16 +25,21 @@
 
 static const unsigned int *ldo_regs;
 
+bool ldo_is_on(enum ldo_id id)
+{
+	return !(__raw_readl(ldo_regs[id]) & SRAMLDO_STATUS);
+}
+
 void ldo_wait_for_on(enum ldo_id id)
 {
 	/* Poll for LDO status to be out of retention (SRAMLDO_STATUS) */
-	while (__raw_readl(ldo_regs[LDO_CORE]) & SRAMLDO_STATUS);
+	while (__raw_readl(ldo_regs[id]) & SRAMLDO_STATUS);
 }
 
 void ldo_wait_for_ret(enum ldo_id id)
 {
 	/* Poll for LDO Status to be in retention (SRAMLDO_STATUS) */
-	while (!(__raw_readl(ldo_regs[LDO_CORE]) & SRAMLDO_STATUS));
+	while (!(__raw_readl(ldo_regs[id]) & SRAMLDO_STATUS));
 }
 
 void ldo_power_up(enum ldo_id id)
@@ -50,6 +56,8 @@ void ldo_power_down(enum ldo_id id)
 {
 	unsigned int val;
 
+	journal_push(JOURNAL_LDO, id);
+
 	/* Configure RETMODE_ENABLE for LDO */
 	val = __raw_readl(ldo_regs[id]);
 	val |= RETMODE_ENABLE;
@@ -25,50 +25,222 @@
 #include <pm_handlers.h>
 #include <trace.h>
 #include <rtc.h>
+#include <resume.h>
+#include <counter32k.h>
+#include <timebase.h>
+#include <state_select.h>
+#include <telemetry.h>
+#include <pmic.h>
+#include <smartreflex.h>
+#include <sync.h>
+#include <journal.h>
+#include <promote.h>
+#include <wake_timer.h>
+#include <crash.h>
+#include <mailbox.h>
 
 /* Debug info */
 static bool halt_on_resume;
 
-/* Enter RTC mode */
-void a8_lp_rtc_handler(struct cmd_data *data)
+/* A8 asked for the MPU to be released before non-critical restores */
+static bool fast_resume;
+static bool defer_clkdms;
+
+/*
+ * A wake interrupt taken while a low power entry is in progress aborts
+ * it. The entry handler checks for this after the costly steps, and the
+ * journal of what it did so far gets replayed as for a regular wakeup.
+ */
+static volatile bool entering;
+static volatile bool entry_aborted;
+static int abort_reason;
+
+static void entry_unwind(void);
+static void entry_fail(void);
+
+/*
+ * Point of no return, wakes from here on take the regular wake path.
+ * WKUP gets gated with the commit so a wake can not see it half done.
+ */
+static bool entry_commit(bool gate_wkup)
 {
-	struct rtc_data *local_cmd = &data->data->rtc;
-	unsigned int timeout;
+	bool committed;
 
-	a8_i2c_sleep_handler(data->i2c_sleep_offset);
+	__asm("cpsid i");
 
-	/* If RTC module if not already configured... cannot continue */
-	rtc_enable_check();
+	committed = !entry_aborted;
+	if (committed) {
+		entering = false;
+		journal_close();
+		telemetry_entry_done();
+		if (gate_wkup)
+			clkdm_sleep(CLKDM_WKUP);
+	}
+
+	__asm("cpsie i");
+
+	return committed;
+}
+
+void pm_entry_begin(void)
+{
+	journal_open();
+	entry_aborted = false;
+	abort_reason = 0;
+	entering = true;
+}
+
+/* For handlers that do not commit the entry themselves */
+void pm_entry_end(void)
+{
+	if (entering && !entry_commit(false))
+		entry_unwind();
+}
+
+/*
+ * ALARM2 time at which pmic_pwr_enable gets deasserted, fails if it
+ * does not fit the RTC
+ */
+static int rtc_power_off_time(struct rtc_data *local_cmd, struct rtc_time *tm)
+{
+	unsigned int timeout;
 
 	if (local_cmd->rtc_timeout_val != 0)
 		timeout = local_cmd->rtc_timeout_val;
 	else
 		timeout = RTC_TIMEOUT_DEFAULT;
 
+	rtc_time_read(RTC_SECONDS_REG, tm);
+	return rtc_time_add(tm, timeout);
+}
+
+/* Power off at tm, everything but the RTC goes down */
+static void rtc_mode_enter(struct cmd_data *data, struct rtc_time *tm)
+{
+	a8_i2c_sleep_handler(data->i2c_sleep_offset);
+
+	/* If RTC module if not already configured... cannot continue */
+	rtc_enable_check();
+
 	/* Program the RTC_PMIC register for deasseting pmic_pwr_enable */
-	rtc_reg_write(0x00010000, RTC_PMIC_REG);
+	rtc_reg_write(RTC_PMIC_PWR_ENABLE_EN, RTC_PMIC_REG);
 
-	timeout += rtc_reg_read(RTC_ALARM2_SECONDS_REG);
+	rtc_time_write(RTC_ALARM2_SECONDS_REG, tm);
 
-	rtc_reg_write(timeout, RTC_ALARM2_SECONDS_REG);
+	/* Turn off interconnect */
+	interconnect_hwmods_disable();
 
-	if (cmd_global_data.cmd_id == CMD_ID_RTC) {
-		/* Turn off interconnect */
-		interconnect_hwmods_disable();
+	/* Disable the clock domains except MPU */
+	clkdms_sleep();
 
-		/* Disable the clock domains except MPU */
-		clkdms_sleep();
+	/* Disable MPU clock domain */
+	clkdm_sleep(CLKDM_MPU);
 
-		/* Disable MPU clock domain */
-		clkdm_sleep(CLKDM_MPU);
+	telemetry_entry_done();
 
-		clkdm_sleep(CLKDM_WKUP);
+	clkdm_sleep(CLKDM_WKUP);
 
-		/*
-		 * TODO: wait for power domain state change interrupt from
-		 * PRCM
-		 */
+	/*
+	 * TODO: wait for power domain state change interrupt from
+	 * PRCM
+	 */
+}
+
+/* Enter RTC mode */
+void a8_lp_rtc_handler(struct cmd_data *data)
+{
+	struct rtc_time tm;
+
+	if (rtc_power_off_time(&data->data->rtc, &tm)) {
+		entry_fail();
+		return;
+	}
+
+	rtc_mode_enter(data, &tm);
+}
+
+static struct rtc_time rtc_fast_alarm;
+
+/*
+ * RTC_FAST does all of its work that does not depend on the A8 being
+ * in WFI when the command arrives. I2C0 still belongs to the A8 until
+ * the trigger, so the PMIC sleep script is left to the trigger.
+ */
+int a8_rtc_fast_prepare_handler(struct cmd_data *data)
+{
+	if (!clkdm_active(CLKDM_RTC))
+		return -1;
+
+	return rtc_power_off_time(&data->data->rtc, &rtc_fast_alarm);
+}
+
+/*
+ * Enter RTC mode as fast as possible, nothing is turned off on the way
+ * as the power off takes it all down anyway. The sleep script is skipped
+ * if an earlier entry already sent it unchanged.
+ */
+void a8_lp_rtc_fast_handler(struct cmd_data *data)
+{
+	struct rtc_time now;
+
+	/* An alarm in the past would never power off */
+	rtc_time_read(RTC_SECONDS_REG, &now);
+	if (rtc_time_to_secs(&now) >= rtc_time_to_secs(&rtc_fast_alarm) &&
+	    rtc_power_off_time(&data->data->rtc, &rtc_fast_alarm)) {
+		entry_fail();
+		return;
+	}
+
+	a8_i2c_sleep_cached_handler(data->i2c_sleep_offset);
+
+	rtc_time_write(RTC_ALARM2_SECONDS_REG, &rtc_fast_alarm);
+	rtc_reg_write(RTC_PMIC_PWR_ENABLE_EN, RTC_PMIC_REG);
+
+	telemetry_entry_done();
+}
+
+/* RTC+DDR needs the AM43xx DDR IO retention */
+int a8_rtc_ddr_prepare_handler(struct cmd_data *data)
+{
+	if (soc_id != AM43XX_SOC_ID || !clkdm_active(CLKDM_RTC))
+		return -1;
+
+	return 0;
+}
+
+/*
+ * Enter RTC+DDR mode: RTC mode with DDR left in self-refresh and its
+ * IOs latched. The A8 sleep script has to keep the DDR rail up while
+ * the rest of the PMIC powers off. The kernel leaves the boot magic and
+ * resume vector for the bootloader in the RTC scratch registers itself.
+ */
+void a8_lp_rtc_ddr_handler(struct cmd_data *data)
+{
+	struct rtc_time tm;
+
+	if (rtc_power_off_time(&data->data->rtc, &tm)) {
+		entry_fail();
+		return;
 	}
+
+	ds_save();
+
+	rtc_mode_enter(data, &tm);
+}
+
+/*
+ * Drop VDD_MPU to the A8 requested level, but only once PD_MPU has
+ * settled so the MPU can never run at the lowered voltage
+ */
+static void vdd_mpu_lower(struct deep_sleep_data *local_cmd)
+{
+	if (!local_cmd->vdd_mpu_val)
+		return;
+
+	if (pd_wait_for_transition(PD_MPU))
+		return;
+
+	pmic_vdd_lower(VDD_MPU, local_cmd->vdd_mpu_val * 1000);
 }
 
 /*
@@ -90,12 +262,10 @@ void a8_lp_ds0_handler(struct cmd_data *data)
 	a8_i2c_sleep_handler(data->i2c_sleep_offset);
 
 	configure_wake_sources(local_cmd->wake_sources);
+	if (entry_aborted)
+		goto abort;
 
-	/* TODO: Check for valid range */
-	if (local_cmd->deepsleep_count)
-		configure_deepsleep_count(local_cmd->deepsleep_count);
-	else
-		configure_deepsleep_count(DS_COUNT_DEFAULT);
+	configure_deepsleep_count(ds_count_select(local_cmd->deepsleep_count));
 
 	per_st = get_pd_per_stctrl_val(local_cmd);
 	mpu_st = get_pd_mpu_stctrl_val(local_cmd);
@@ -107,22 +277,33 @@ void a8_lp_ds0_handler(struct cmd_data *data)
 
 	/* PER power domain state change */
 	pd_state_change(per_st, PD_PER);
+	if (entry_aborted)
+		goto abort;
 
 	/* XXX: New addition to resolve any issues that A8 might have */
 	essential_hwmods_disable();
 
 	interconnect_hwmods_disable();
+	if (entry_aborted)
+		goto abort;
 
 	/* DPLL retention update for PG 2.0 */
 	plls_power_down();
+	if (entry_aborted)
+		goto abort;
 
 	clkdm_sleep(CLKDM_MPU);
 
 	clkdms_sleep();
+	if (entry_aborted)
+		goto abort;
 
 	/* Disable MOSC if defaults are required or if user asked for it */
 	if (local_cmd->mosc_state == MOSC_OFF) {
 		disable_master_oscillator();
+		if (entry_aborted)
+			goto abort;
+
 		/* Core LDO retention for PG 2.0 if PD_PER is in RET */
 		if ((soc_id == AM335X_SOC_ID && soc_rev > AM335X_REV_ES1_0) ||
 				(soc_id == AM43XX_SOC_ID)) {
@@ -139,7 +320,11 @@ void a8_lp_ds0_handler(struct cmd_data *data)
 	}
 
 	/* TODO: wait for power domain state change interrupt from PRCM */
-	clkdm_sleep(CLKDM_WKUP);
+	if (entry_commit(true))
+		return;
+
+abort:
+	entry_unwind();
 }
 
 /*
@@ -164,12 +349,10 @@ void a8_lp_ds1_handler(struct cmd_data *data)
 		disable_master_oscillator();
 
 	configure_wake_sources(local_cmd->wake_sources);
+	if (entry_aborted)
+		goto abort;
 
-	/* TODO: Check for valid range */
-	if (local_cmd->deepsleep_count)
-		configure_deepsleep_count(local_cmd->deepsleep_count);
-	else
-		configure_deepsleep_count(DS_COUNT_DEFAULT);
+	configure_deepsleep_count(ds_count_select(local_cmd->deepsleep_count));
 
 	per_st = get_pd_per_stctrl_val(local_cmd);
 	mpu_st = get_pd_mpu_stctrl_val(local_cmd);
@@ -179,15 +362,24 @@ void a8_lp_ds1_handler(struct cmd_data *data)
 
 	/* PER power domain state change */
 	pd_state_change(per_st, PD_PER);
+	if (entry_aborted)
+		goto abort;
 
 	/* DPLL retention update for PG 2.0 */
 	plls_power_down();
+	if (entry_aborted)
+		goto abort;
 
 	clkdm_sleep(CLKDM_MPU);
 
-	clkdm_sleep(CLKDM_WKUP);
+	vdd_mpu_lower(local_cmd);
 
 	/* TODO: wait for power domain state change interrupt from PRCM */
+	if (entry_commit(true))
+		return;
+
+abort:
+	entry_unwind();
 }
 
 /*
@@ -212,12 +404,10 @@ void a8_lp_ds2_handler(struct cmd_data *data)
 		disable_master_oscillator();
 
 	configure_wake_sources(local_cmd->wake_sources);
+	if (entry_aborted)
+		goto abort;
 
-	/* TODO: Check for valid range */
-	if (local_cmd->deepsleep_count)
-		configure_deepsleep_count(local_cmd->deepsleep_count);
-	else
-		configure_deepsleep_count(DS_COUNT_DEFAULT);
+	configure_deepsleep_count(ds_count_select(local_cmd->deepsleep_count));
 
 	per_st = get_pd_per_stctrl_val(local_cmd);
 	mpu_st = get_pd_mpu_stctrl_val(local_cmd);
@@ -227,13 +417,22 @@ void a8_lp_ds2_handler(struct cmd_data *data)
 
 	/* PER power domain state change */
 	pd_state_change(per_st, PD_PER);
+	if (entry_aborted)
+		goto abort;
 
 	/* DPLL retention update for PG 2.0 */
 	plls_power_down();
+	if (entry_aborted)
+		goto abort;
 
-	clkdm_sleep(CLKDM_WKUP);
+	vdd_mpu_lower(local_cmd);
 
 	/*TODO: wait for power domain state change interrupt from PRCM */
+	if (entry_commit(true))
+		return;
+
+abort:
+	entry_unwind();
 }
 
 void a8_standby_handler(struct cmd_data *data)
@@ -248,18 +447,25 @@ void a8_standby_handler(struct cmd_data *data)
 
 	configure_wake_sources(local_cmd->wake_sources);
 
-	/* TODO: Check for valid range */
-	if (local_cmd->deepsleep_count)
-		configure_deepsleep_count(local_cmd->deepsleep_count);
-	else
-		configure_deepsleep_count(DS_COUNT_DEFAULT);
+	configure_deepsleep_count(ds_count_select(local_cmd->deepsleep_count));
 
 	mpu_st = get_pd_mpu_stctrl_val(local_cmd);
 
 	/* MPU power domain state change */
 	pd_state_change(mpu_st, PD_MPU);
 
+	/*
+	 * Retained MPU memories are fed by the MPU SRAM LDO, let it drop to
+	 * retention along with the domain. ds_save() already took care of
+	 * this if DDR is handled by the CM3.
+	 */
+	if (local_cmd->pd_mpu_state == PD_RET &&
+	    !cmd_handlers[cmd_global_data.cmd_id].do_ddr)
+		ldo_power_down(LDO_MPU);
+
 	clkdm_sleep(CLKDM_MPU);
+
+	vdd_mpu_lower(local_cmd);
 }
 
 void a8_cpuidle_handler(struct cmd_data *data)
@@ -274,10 +480,16 @@ void a8_cpuidle_handler(struct cmd_data *data)
 void a8_cpuidle_v2_handler(struct cmd_data *data)
 {
 	struct deep_sleep_data *local_cmd = &data->data->deep_sleep;
+	bool shallow = state_idle_short();
 	unsigned int per_st;
 	unsigned int mpu_st;
 
-	pll_bypass(DPLL_MPU);
+	/* Relocking costs more than a short idle would save */
+	if (shallow)
+		telemetry_idle_shallow();
+	else
+		pll_bypass(DPLL_MPU);
+	msg_idle_shallow_update(shallow);
 
 	a8_i2c_sleep_handler(data->i2c_sleep_offset);
 
@@ -296,6 +508,14 @@ void a8_cpuidle_v2_handler(struct cmd_data *data)
 		hwmod_disable(HWMOD_IEEE5000);
 
 	clkdm_sleep(CLKDM_MPU);
+
+	/* The CM3 takes the idle deeper on its own from here on */
+	if (entry_commit(false)) {
+		state_idle_start();
+		promote_start(local_cmd);
+	} else {
+		entry_unwind();
+	}
 }
 
 /* Standalone application handler */
@@ -304,53 +524,428 @@ void a8_standalone_handler(struct cmd_data *data)
 	/* TBD */
 }
 
+/* Rail descriptions needed before the CM3 can drive the PMIC itself */
+void a8_pmic_config_handler(struct cmd_data *data)
+{
+	unsigned char *dmem = (unsigned char *) DMEM_BASE;
+	unsigned int offset = msg_read(PARAM1_REG) & 0xffff;
+
+	if (pmic_configure((struct pmic_vdd_cfg *) (dmem + offset)))
+		a8_notify(CMD_STAT_FAIL);
+	else
+		a8_notify(CMD_STAT_PASS);
+}
+
+/*
+ * PARAM1: DMEM offset of one struct sr_cfg per VDD
+ * PARAM2: Mask of the VDDs to run AVS on, others are stopped
+ */
+void a8_avs_handler(struct cmd_data *data)
+{
+	unsigned char *dmem = (unsigned char *) DMEM_BASE;
+	struct sr_cfg *cfg;
+	unsigned int mask;
+	int ret = 0;
+	int i;
+
+	cfg = (struct sr_cfg *) (dmem + (msg_read(PARAM1_REG) & 0xffff));
+	mask = msg_read(PARAM2_REG);
+
+	for (i = 0; i < VDD_COUNT; i++) {
+		if (mask & (1 << i))
+			ret |= sr_enable(i, &cfg[i]);
+		else
+			sr_disable(i);
+	}
+
+	a8_notify(ret ? CMD_STAT_FAIL : CMD_STAT_PASS);
+}
+
+/*
+ * PARAM1: Wake time in seconds
+ * PARAM2: 0 if PARAM1 is relative to now, 1 if it counts from
+ *         2000-01-01 00:00:00
+ */
+void a8_rtc_alarm_handler(struct cmd_data *data)
+{
+	if (rtc_alarm_set(msg_read(PARAM1_REG), msg_read(PARAM2_REG) & 1))
+		a8_notify(CMD_STAT_FAIL);
+	else
+		a8_notify(CMD_STAT_PASS);
+}
+
+/*
+ * PARAM1: Deadline in DMTIMER1_1MS ticks
+ * PARAM2: bits 15-0: Tolerance in ms, how late the wake may come
+ *         bits 29-16: Deadline ID, a new deadline replaces one with the same ID
+ *         bit 30: The CM3 may use the RTC alarm, the kernel RTC driver
+ *                 does not use it until the wake
+ *         bit 31: Cancel the deadline with this ID instead
+ * Fails if DMTIMER1_1MS is not running from a 32K clock
+ */
+void a8_wake_timer_handler(struct cmd_data *data)
+{
+	unsigned int param2 = msg_read(PARAM2_REG);
+	unsigned int id = (param2 >> 16) & 0x3fff;
+	int ret = 0;
+
+	if (param2 & 0x80000000)
+		wake_timer_cancel(id);
+	else
+		ret = wake_timer_add(msg_read(PARAM1_REG), param2 & 0xffff, id,
+						(param2 & 0x40000000) != 0);
+
+	a8_notify(ret ? CMD_STAT_FAIL : CMD_STAT_PASS);
+}
+
+/*
+ * PARAM1: Idle time in ms before each cpuidle promotion step, 0 disables
+ * PARAM2: Deepest enum promote_level the CM3 may take cpuidle to
+ */
+void a8_promote_config_handler(struct cmd_data *data)
+{
+	if (promote_configure(msg_read(PARAM1_REG), msg_read(PARAM2_REG)))
+		a8_notify(CMD_STAT_FAIL);
+	else
+		a8_notify(CMD_STAT_PASS);
+}
+
+/* PARAM1: Guard band added to the measured crystal startup, % */
+void a8_ds_count_config_handler(struct cmd_data *data)
+{
+	if (ds_count_configure(msg_read(PARAM1_REG)))
+		a8_notify(CMD_STAT_FAIL);
+	else
+		a8_notify(CMD_STAT_PASS);
+}
+
+/*
+ * PARAM1: Mailbox FIFO to post command completions to,
+ *         MAILBOX_FIFO_NONE stops posting
+ */
+void a8_mailbox_config_handler(struct cmd_data *data)
+{
+	if (mailbox_configure(msg_read(PARAM1_REG)))
+		a8_notify(CMD_STAT_FAIL);
+	else
+		a8_notify(CMD_STAT_PASS);
+}
+
+/*
+ * DPLLs a fast resume may relock after the MPU is running. PER stays
+ * critical for wake sources whose A8 handlers need its clocks at once.
+ */
+static unsigned int resume_deferred_plls(int wakeup_reason)
+{
+	unsigned int mask = 1 << DPLL_DISP;
+
+	switch (wakeup_reason) {
+	case CM3_IRQ_USBWAKEUP:
+	case CM3_IRQ_USB0WOUT:
+	case CM3_IRQ_USB1WOUT:
+	case CM3_IRQ_I2C0_WAKE:
+	case CM3_IRQ_UART0_WAKE:
+		break;
+	default:
+		mask |= 1 << DPLL_PER;
+	}
+
+	return mask;
+}
+
+/* Restores left for after the MPU has been released on a fast resume */
+static void resume_deferred(void)
+{
+	if (defer_clkdms) {
+		clkdms_wake_deferred();
+		defer_clkdms = false;
+	}
+
+	ds_restore_deferred();
+
+	msg_resume_pending_update(false);
+}
+
+/* NVIC lines 32-63 that end up in generic_wake_handler() */
+#define WAKE_IRQS_MASK		((1 << (CM3_IRQ_USBWAKEUP - 32)) |	\
+				 (1 << (CM3_IRQ_USB0WOUT - 32)) |	\
+				 (1 << (CM3_IRQ_USB1WOUT - 32)) |	\
+				 (0x1fff << (CM3_IRQ_I2C0_WAKE - 32)))
+
+/* Set from the claim of a wakeup until its handling is complete */
+static bool wake_claimed;
+
+void pm_nvic_flush(void)
+{
+	int i;
+
+	for (i = 0; i < CM3_NUM_EXT_INTERRUPTS; i++) {
+		nvic_disable_irq(i);
+		nvic_clear_irq(i);
+	}
+
+	/* Tamper swakeup, a new addition for AM43XX SOCs */
+	if (soc_id == AM43XX_SOC_ID) {
+		nvic_disable_irq(CM3_IRQ_TPM_WAKE);
+		nvic_clear_irq(CM3_IRQ_TPM_WAKE);
+	}
+}
+
+/* Wake interrupts preempt everything else, the entry sequence included */
+void pm_nvic_init(void)
+{
+	int i;
+
+	for (i = 0; i < 64; i++) {
+		if (i >= 32 && (WAKE_IRQS_MASK & (1 << (i - 32))))
+			nvic_set_priority(i, NVIC_PRIO_HIGH);
+		else
+			nvic_set_priority(i, NVIC_PRIO_LOW);
+	}
+}
+
+/*
+ * Several wake lines can fire for the same wakeup, or fire again while
+ * the CM3 is still busy with it. Only the first one gets to run the
+ * wake sequence. The pending state of the others is recorded along with
+ * the wake IRQ before all lines get disabled and cleared, so they are
+ * reported as part of the same wakeup. Wake interrupts that still make
+ * it here afterwards are recorded as late arrivals.
+ */
+static bool wake_claim(int wakeup_reason)
+{
+	bool claimed = false;
+
+	__asm("cpsid i");
+
+	if (entering) {
+		/* The entry handler notices and unwinds what it did so far */
+		if (!entry_aborted) {
+			entry_aborted = true;
+			abort_reason = wakeup_reason;
+			telemetry_wake(wakeup_reason);
+			pm_nvic_flush();
+		}
+	} else if (!wake_claimed && msg_cmd_is_valid() &&
+	    cmd_handlers[cmd_global_data.cmd_id].wake_handler) {
+		wake_claimed = true;
+		claimed = true;
+
+		promote_stop();
+
+		/* TIMER0, I2C0 and the wake sources sit in the WKUP clockdomain */
+		if (clkdm_sleeping(CLKDM_WKUP))
+			clkdm_wake(CLKDM_WKUP);
+
+		telemetry_wake(wakeup_reason);
+		pm_nvic_flush();
+	} else {
+		telemetry_wake_late(1 << (wakeup_reason - 32));
+	}
+
+	__asm("cpsie i");
+
+	return claimed;
+}
+
+/*
+ * Power the Core LDO and the DPLLs back up together, the LDO ramp and
+ * the DPLL power switches settle in parallel
+ */
+static void replay_power_up(void)
+{
+	unsigned int stages = 0;
+
+	if (journal_contains(JOURNAL_LDO, LDO_CORE))
+		stages |= RESUME_STAGE(RESUME_LDO_CORE);
+
+	if (journal_contains(JOURNAL_PLLS, 0))
+		stages |= RESUME_PLLS;
+
+	resume_stages_run(stages);
+}
+
+/*
+ * Undo the low power entry by replaying its journal in reverse. Returns
+ * true if the MPU clockdomain was put to sleep, waking it is left to the
+ * caller so the MPU only runs once everything else has been restored.
+ */
+static bool journal_replay(int wakeup_reason)
+{
+	bool powered_up = false;
+	bool mpu_gated = false;
+	enum journal_op op;
+	int arg;
+
+	while (journal_pop(&op, &arg)) {
+		switch (op) {
+		case JOURNAL_PD_STATE:
+			pd_state_restore(arg);
+			break;
+		case JOURNAL_CLKDM:
+			if (arg == CLKDM_MPU)
+				mpu_gated = true;
+			else
+				clkdm_wake(arg);
+			break;
+		case JOURNAL_CLKDMS:
+			if (fast_resume) {
+				clkdms_wake_critical();
+				defer_clkdms = true;
+			} else {
+				clkdms_wake();
+			}
+			break;
+		case JOURNAL_HWMOD:
+			hwmod_enable(arg);
+			break;
+		case JOURNAL_ESSENTIAL_HWMODS:
+			essential_hwmods_enable();
+			break;
+		case JOURNAL_INTERCONNECT:
+			interconnect_hwmods_enable();
+			break;
+		case JOURNAL_PLL_BYPASS:
+			pll_lock(arg);
+			break;
+		case JOURNAL_LDO:
+			if (arg != LDO_CORE) {
+				ldo_power_up(arg);
+				ldo_wait_for_on(arg);
+				break;
+			}
+			/* fall through */
+		case JOURNAL_PLLS:
+			if (!powered_up)
+				replay_power_up();
+			powered_up = true;
+			break;
+		case JOURNAL_MOSC:
+			enable_master_oscillator();
+			break;
+		case JOURNAL_VDD:
+			pmic_vdd_restore(arg);
+			break;
+		case JOURNAL_WAKE_SOURCES:
+			clear_wake_sources();
+			break;
+		case JOURNAL_I2C_SLEEP:
+			a8_i2c_wake_handler(cmd_global_data.i2c_wake_offset);
+			break;
+		case JOURNAL_DDR:
+			if (fast_resume)
+				ds_restore_critical(resume_deferred_plls(wakeup_reason));
+			else
+				ds_restore();
+			break;
+		}
+	}
+
+	return mpu_gated;
+}
+
+/* DS2 leaves the MPU clocked, it only needs an event to continue */
+static void mpu_release(bool mpu_gated)
+{
+	if (mpu_gated)
+		clkdm_wake(CLKDM_MPU);
+	else
+		__asm("sev");
+
+	hwmod_enable(HWMOD_MPU);
+}
+
+/*
+ * Back out of an entry. The A8 never lost context, it falls out of WFI
+ * once its clocks are back and finds stat.
+ */
+static void entry_back_out(unsigned int stat)
+{
+	bool i2c_resync = journal_contains(JOURNAL_I2C_SLEEP, 0) &&
+				cmd_global_data.i2c_wake_offset != 0xffff;
+	bool mpu_gated;
+
+	entering = false;
+	journal_close();
+
+	telemetry_entry_abort(stat == CMD_STAT_FAIL);
+
+	fast_resume = false;
+	mpu_gated = journal_replay(abort_reason);
+
+	msg_cmd_stat_update(stat);
+	msg_cmd_wakeup_reason_update(abort_reason);
+
+	pm_nvic_flush();
+
+	trace_init();
+
+	pm_reset();
+
+	nvic_enable_irq(CM3_IRQ_MBINT0);
+	nvic_enable_irq(53);
+
+	sr_resume(i2c_resync);
+
+	mpu_release(mpu_gated);
+}
+
+/* Entry aborted by a wake event */
+static void entry_unwind(void)
+{
+	entry_back_out(CMD_STAT_ABORT);
+}
+
+/* Entry the handler found it can not complete */
+static void entry_fail(void)
+{
+	entry_back_out(CMD_STAT_FAIL);
+}
+
 /* All wake interrupts invoke this function */
 void generic_wake_handler(int wakeup_reason)
 {
-	int i;
+	enum cmd_ids cmd_id = cmd_global_data.cmd_id;
+	unsigned int exit_us;
+	unsigned int start;
+	bool mpu_gated;
 
 	if (halt_on_resume)
-		while(1);
+		crash(CRASH_HALT_ON_RESUME);
 
-	/*
-	 * Assuming that cmd_id is a valid reflection of what we did
-	 */
-	if (!msg_cmd_is_valid() ||
-	    !cmd_handlers[cmd_global_data.cmd_id].wake_handler)
-		while(1);
+	if (!wake_claim(wakeup_reason))
+		return;
 
-	cmd_handlers[cmd_global_data.cmd_id].wake_handler();
+	start = counter32k_read();
 
-	msg_cmd_wakeup_reason_update(wakeup_reason);
+	if (cmd_id == CMD_ID_CPUIDLE_V2)
+		state_idle_end(wakeup_reason);
 
 	if (cmd_global_data.data->deep_sleep.mosc_state == MOSC_OFF)
-		enable_master_oscillator();
+		ds_count_tune();
 
-	a8_i2c_wake_handler(cmd_global_data.i2c_wake_offset);
+	fast_resume = cmd_global_data.data->deep_sleep.fast_resume;
 
-	if (cmd_handlers[cmd_global_data.cmd_id].do_ddr)
-		ds_restore();
+	/* Checks the power domain transitions before they get undone */
+	cmd_handlers[cmd_global_data.cmd_id].wake_handler();
+
+	msg_cmd_wakeup_reason_update(wakeup_reason);
+
+	mpu_gated = journal_replay(wakeup_reason);
 
 	/*
 	 * PSP kernels have a long standing bug in sleep33xx.S,
 	 * they don't re-enable the EMIF hwmod in their resume
-	 * path. Keep compatibily with these kernels.
+	 * path. Keep compatibily with these kernels. The kernel
+	 * disabled it, so the journal has no record of it.
 	 */
 	if (!cmd_handlers[cmd_global_data.cmd_id].do_ddr)
 		hwmod_enable(HWMOD_EMIF);
 
 	/* If everything is done, we init things again */
-	/* Flush out NVIC interrupts */
-	for (i = 0; i < CM3_NUM_EXT_INTERRUPTS; i++) {
-		nvic_disable_irq(i);
-		nvic_clear_irq(i);
-	}
-
-	/* Flush out Tamper swakeup, a new addition for AM43XX SOCs */
-	if (soc_id == AM43XX_SOC_ID) {
-		nvic_disable_irq(CM3_IRQ_TPM_WAKE);
-		nvic_clear_irq(CM3_IRQ_TPM_WAKE);
-	}
+	/* Flush out NVIC interrupts, noting wakes that came in meanwhile */
+	telemetry_wake_late(__raw_readl(NVIC_IRQ_SET_PEND2) & WAKE_IRQS_MASK);
+	pm_nvic_flush();
 
 	trace_init();
 
@@ -360,14 +955,38 @@ void generic_wake_handler(int wakeup_reason)
 	nvic_enable_irq(CM3_IRQ_MBINT0);
 	nvic_enable_irq(53);
 
+	/* AVS picks up where it left, the wake sequence may have reset the rails */
+	sr_resume(cmd_global_data.i2c_wake_offset != 0xffff);
+
+	exit_us = timebase_ticks_to_us(counter32k_read() - start);
+	state_exit_latency_update(cmd_id, exit_us);
+	telemetry_exit_done(cmd_id, exit_us,
+			(msg_read(STAT_ID_REG) >> 16) == CMD_STAT_FAIL);
+
+	if (fast_resume)
+		msg_resume_pending_update(true);
+
 	/* Enable MPU only after we are sure that we are done with the wakeup */
-	hwmod_enable(HWMOD_MPU);
+	mpu_release(mpu_gated);
+
+	if (fast_resume)
+		resume_deferred();
+
+	wake_claimed = false;
 }
 
+/*
+ * The wake handlers only report on the low power transition, what the
+ * entry changed is undone by generic_wake_handler() from the journal.
+ */
+
 /* Exit RTC mode */
 void a8_wake_rtc_handler(void)
 {
-	/* RTC wake is a cold boot... so this doesn't make sense */
+	/*
+	 * RTC wake is a cold boot... so this doesn't make sense. For
+	 * RTC+DDR the bootloader picks up the resume from RTC scratch.
+	 */
 }
 
 /*
@@ -378,34 +997,7 @@ void a8_wake_rtc_handler(void)
  */
 void a8_wake_ds0_handler(void)
 {
-	int result;
-
-	if ((soc_id == AM335X_SOC_ID && soc_rev > AM335X_REV_ES1_0) ||
-			(soc_id == AM43XX_SOC_ID)) {
-		ldo_power_up(LDO_CORE);
-		ldo_wait_for_on(LDO_CORE);
-	}
-
-	result = verify_pd_transitions();
-
-	pd_state_restore(PD_PER);
-	pd_state_restore(PD_MPU);
-
-	clkdm_wake(CLKDM_WKUP);
-
-	clkdms_wake();
-
-	plls_power_up();
-
-	interconnect_hwmods_enable();
-
-	essential_hwmods_enable();
-
-	msg_cmd_stat_update(result);
-
-	clear_wake_sources();
-
-	clkdm_wake(CLKDM_MPU);
+	msg_cmd_stat_update(verify_pd_transitions());
 }
 
 /*
@@ -416,24 +1008,7 @@ void a8_wake_ds0_handler(void)
  */
 void a8_wake_ds1_handler(void)
 {
-	int result;
-
-	result = verify_pd_transitions();
-
-	pd_state_restore(PD_PER);
-	pd_state_restore(PD_MPU);
-
-	clkdm_wake(CLKDM_WKUP);
-
-	plls_power_up();
-
-	essential_hwmods_enable();
-
-	msg_cmd_stat_update(result);
-
-	clear_wake_sources();
-
-	clkdm_wake(CLKDM_MPU);
+	msg_cmd_stat_update(verify_pd_transitions());
 }
 
 /*
@@ -444,45 +1019,17 @@ void a8_wake_ds1_handler(void)
  */
 void a8_wake_ds2_handler(void)
 {
-	int result;
-
-	result = verify_pd_transitions();
-
-	pd_state_restore(PD_PER);
-	pd_state_restore(PD_MPU);
-
-	clkdm_wake(CLKDM_WKUP);
-
-	plls_power_up();
-
-	msg_cmd_stat_update(result);
-
-	/* Interrupt MPU now */
-	__asm("sev");
-
-	clear_wake_sources();
+	msg_cmd_stat_update(verify_pd_transitions());
 }
 
 /* Exit Standby mode
  * MOSC = ON
  * PD_PER = ON
- * PD_MPU = OFF
+ * PD_MPU = OFF, RET for CMD_ID_STANDBY_RET
  */
 void a8_wake_standby_handler(void)
 {
-	int result;
-
-	result = verify_pd_transitions();
-
-	pd_state_restore(PD_MPU);
-
-	essential_hwmods_enable();
-
-	msg_cmd_stat_update(result);
-
-	clear_wake_sources();
-
-	clkdm_wake(CLKDM_MPU);
+	msg_cmd_stat_update(verify_pd_transitions());
 }
 
 /* Exit cpuidle
@@ -490,34 +1037,19 @@ void a8_wake_standby_handler(void)
  */
 void a8_wake_cpuidle_handler(void)
 {
-	clear_wake_sources();
-
-	clkdm_wake(CLKDM_MPU);
 }
 
 /* Exit Idle mode
  * MOSC = ON
  * PD_PER = ON
  * PD_MPU = OFF
+ *
+ * A PER retention promoted by the CM3 is only best effort.
  */
 void a8_wake_cpuidle_v2_handler(void)
 {
-	int result;
-
-	result = verify_pd_transitions();
-
-	pd_state_restore(PD_PER);
-	pd_state_restore(PD_MPU);
-
-	clkdms_wake();
-
-	essential_hwmods_enable();
-
-	msg_cmd_stat_update(result);
-
-	clear_wake_sources();
-
-	clkdm_wake(CLKDM_MPU);
-
-	pll_lock(DPLL_MPU);
+	if (promote_reached() >= PROMOTE_PER_RET)
+		msg_cmd_stat_update(verify_pd_transition(PD_MPU));
+	else
+		msg_cmd_stat_update(verify_pd_transitions());
 }
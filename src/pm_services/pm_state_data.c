@@ -121,6 +121,21 @@ union state_data standby_data = {
 	},
 };
 
+/* MPU context and caches retained, the A8 resumes with warm caches */
+union state_data standby_ret_data = {
+	.deep_sleep = {
+		.mosc_state			= MOSC_ON,
+		.deepsleep_count		= DS_COUNT_DEFAULT,
+
+		.pd_mpu_state			= PD_RET,
+		.pd_mpu_ram_ret_state		= MEM_BANK_RET_ST_RET,
+		.pd_mpu_l1_ret_state		= MEM_BANK_RET_ST_RET,
+		.pd_mpu_l2_ret_state		= MEM_BANK_RET_ST_RET,
+
+		.wake_sources			= WAKE_ALL | MPU_WAKE,
+	},
+};
+
 union state_data idle_data = {
 	.deep_sleep = {
 		.mosc_state			= MOSC_ON,
@@ -0,0 +1,168 @@
+/*
+ * AM33XX-CM3 firmware
+ *
+ * Cortex-M3 (CM3) firmware for power management on Texas Instruments' AM33XX series of SoCs
+ *
+ * Copyright (C) 2011 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  This software is licensed under the  standard terms and conditions in the Texas Instruments  Incorporated
+ *  Technology and Software Publicly Available Software License Agreement , a copy of which is included in the
+ *  software download.
+*/
+
+#include <stddef.h>
+#include <cm3.h>
+#include <prcm_core.h>
+#include <pmic.h>
+#include <journal.h>
+
+/*
+ * Copy of the rail descriptions, the A8 is free to reuse the DMEM
+ * area it passed them in once the command has completed
+ */
+static struct pmic_vdd_cfg vdds[VDD_COUNT];
+
+/* Selector to go back to on wake for rails lowered during sleep */
+static struct {
+	unsigned char vsel;
+	bool lowered;
+} vdd_restore[VDD_COUNT];
+
+int pmic_configure(const struct pmic_vdd_cfg *cfg)
+{
+	int i;
+
+	for (i = 0; i < VDD_COUNT; i++) {
+		if (cfg[i].step_uv && cfg[i].vsel_min > cfg[i].vsel_max)
+			return -1;
+	}
+
+	for (i = 0; i < VDD_COUNT; i++) {
+		vdds[i] = cfg[i];
+		vdd_restore[i].lowered = false;
+	}
+
+	return 0;
+}
+
+/* A rail with no voltage step has not been described by the A8 */
+bool pmic_vdd_valid(enum vdd_id id)
+{
+	return vdds[id].step_uv != 0;
+}
+
+unsigned int pmic_vdd_get_vsel(enum vdd_id id)
+{
+	return vdds[id].vsel;
+}
+
+int pmic_vdd_set_vsel(enum vdd_id id, unsigned int vsel)
+{
+	struct pmic_vdd_cfg *vdd = &vdds[id];
+	unsigned char seq[7];
+	int ret;
+
+	if (!pmic_vdd_valid(id))
+		return -1;
+
+	vsel = max(vsel, vdd->vsel_min);
+	vsel = min(vsel, vdd->vsel_max);
+
+	/* Same format as the A8 supplied sleep/wake sequences */
+	seq[0] = vdd->speed_khz & 0xff;
+	seq[1] = vdd->speed_khz >> 8;
+	seq[2] = 2;
+	seq[3] = vdd->slave_addr;
+	seq[4] = vdd->vsel_reg;
+	seq[5] = vsel;
+	seq[6] = 0;
+
+	ret = pm_i2c_write(seq);
+	if (!ret)
+		vdd->vsel = vsel;
+
+	return ret;
+}
+
+/* Rounds up so that the rail never ends up below the requested voltage */
+unsigned int pmic_uv_to_vsel(enum vdd_id id, unsigned int uv)
+{
+	struct pmic_vdd_cfg *vdd = &vdds[id];
+
+	if (!pmic_vdd_valid(id) || uv <= vdd->min_uv)
+		return vdd->vsel_min;
+
+	return min(vdd->vsel_min + (uv - vdd->min_uv + vdd->step_uv - 1) /
+					vdd->step_uv, vdd->vsel_max);
+}
+
+unsigned int pmic_vsel_to_uv(enum vdd_id id, unsigned int vsel)
+{
+	struct pmic_vdd_cfg *vdd = &vdds[id];
+
+	if (vsel < vdd->vsel_min)
+		vsel = vdd->vsel_min;
+
+	return vdd->min_uv + (vsel - vdd->vsel_min) * vdd->step_uv;
+}
+
+/* Time for the rail to settle after moving between two selectors */
+static unsigned int pmic_ramp_us(enum vdd_id id, unsigned int from,
+							unsigned int to)
+{
+	unsigned int from_uv = pmic_vsel_to_uv(id, from);
+	unsigned int to_uv = pmic_vsel_to_uv(id, to);
+	unsigned int delta = from_uv > to_uv ? from_uv - to_uv : to_uv - from_uv;
+
+	return (delta + vdds[id].slew_uv - 1) / vdds[id].slew_uv;
+}
+
+/*
+ * Drop a rail to the requested voltage, remembering the current selector
+ * for pmic_vdd_restore(). Requests that would raise the rail are ignored.
+ */
+int pmic_vdd_lower(enum vdd_id id, unsigned int uv)
+{
+	unsigned int prev = vdds[id].vsel;
+	unsigned int vsel;
+
+	if (!pmic_vdd_valid(id) || !vdds[id].slew_uv)
+		return -1;
+
+	vsel = pmic_uv_to_vsel(id, uv);
+	if (vsel >= prev)
+		return -1;
+
+	if (pmic_vdd_set_vsel(id, vsel))
+		return -1;
+
+	vdd_restore[id].vsel = prev;
+	vdd_restore[id].lowered = true;
+	journal_push(JOURNAL_VDD, id);
+
+	return 0;
+}
+
+bool pmic_vdd_lowered(enum vdd_id id)
+{
+	return vdd_restore[id].lowered;
+}
+
+/* Returns once the rail has ramped back to its pre-sleep voltage */
+int pmic_vdd_restore(enum vdd_id id)
+{
+	unsigned int from = vdds[id].vsel;
+	int ret;
+
+	if (!vdd_restore[id].lowered)
+		return 0;
+
+	ret = pmic_vdd_set_vsel(id, vdd_restore[id].vsel);
+	if (ret)
+		return ret;
+
+	vdd_restore[id].lowered = false;
+	udelay(pmic_ramp_us(id, from, vdds[id].vsel));
+
+	return 0;
+}
@@ -17,6 +17,8 @@
 #include <powerdomain.h>
 #include <powerdomain_335x.h>
 #include <powerdomain_43xx.h>
+#include <telemetry.h>
+#include <journal.h>
 
 #define PD_STATE_MASK	0x3
 
@@ -24,6 +26,7 @@ struct powerdomain_state {
 	unsigned int stctrl_next_val;
 	unsigned int stctrl_prev_val;
 	unsigned int pwrstst_prev_val;
+	bool changed;
 };
 
 static const struct pd_mpu_bits *mpu_bits;
@@ -45,6 +48,8 @@ void powerdomain_reset(void)
 	pd_states[PD_PER].stctrl_next_val = 0;
 	pd_states[PD_PER].stctrl_prev_val = 0;
 	pd_states[PD_PER].pwrstst_prev_val = 0;
+	pd_states[PD_MPU].changed = false;
+	pd_states[PD_PER].changed = false;
 }
 
 void powerdomain_init(void)
@@ -60,11 +65,20 @@ void powerdomain_init(void)
 	}
 }
 
+/*
+ * A domain can be changed again before it is restored, the state to
+ * restore is the one from before the first change.
+ */
 unsigned int pd_state_change(unsigned int val, enum powerdomain_id pd)
 {
+	if (!pd_states[pd].changed) {
+		journal_push(JOURNAL_PD_STATE, pd);
+		pd_states[pd].stctrl_prev_val = __raw_readl(pd_regs[pd].stctrl);
+		pd_states[pd].pwrstst_prev_val = __raw_readl(pd_regs[pd].pwrstst);
+		pd_states[pd].changed = true;
+	}
+
 	pd_states[pd].stctrl_next_val = val;
-	pd_states[pd].stctrl_prev_val = __raw_readl(pd_regs[pd].stctrl);
-	pd_states[pd].pwrstst_prev_val = __raw_readl(pd_regs[pd].pwrstst);
 	__raw_writel(val, pd_regs[pd].stctrl);
 
 	return 0;
@@ -153,6 +167,7 @@ unsigned int get_pd_mpu_stctrl_val(struct deep_sleep_data *data)
 void pd_state_restore(enum powerdomain_id pd)
 {
 	__raw_writel(pd_states[pd].stctrl_prev_val, pd_regs[pd].stctrl);
+	pd_states[pd].changed = false;
 }
 
 unsigned int pd_read_state(enum powerdomain_id pd)
@@ -161,7 +176,7 @@ unsigned int pd_read_state(enum powerdomain_id pd)
 }
 
 /* Checking only the stst bits for now */
-static int verify_pd_transition(enum powerdomain_id pd)
+int verify_pd_transition(enum powerdomain_id pd)
 {
 	unsigned int ctrl;
 	unsigned int stst;
@@ -175,14 +190,33 @@ static int verify_pd_transition(enum powerdomain_id pd)
 		return CMD_STAT_FAIL;
 }
 
+/* Poll until the domain has reached its programmed state */
+int pd_wait_for_transition(enum powerdomain_id pd)
+{
+	int i;
+
+	for (i = 0; i < PD_TRANSITION_TIMEOUT; i++) {
+		if (verify_pd_transition(pd) == CMD_STAT_PASS)
+			return 0;
+	}
+
+	return -1;
+}
+
 int verify_pd_transitions(void)
 {
 	int result;
 
 	result = verify_pd_transition(PD_MPU);
-	if (result == CMD_STAT_FAIL)
+	if (result == CMD_STAT_FAIL) {
+		telemetry_pd_failure(PD_MPU);
 		return result;
+	}
+
+	result = verify_pd_transition(PD_PER);
+	if (result == CMD_STAT_FAIL)
+		telemetry_pd_failure(PD_PER);
 
-	return verify_pd_transition(PD_PER);
+	return result;
 }
 
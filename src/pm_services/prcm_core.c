@@ -24,6 +24,10 @@
 #include <ldo.h>
 #include <msg.h>
 #include <i2c.h>
+#include <counter32k.h>
+#include <timebase.h>
+#include <journal.h>
+#include <wake_timer.h>
 
 #define BITBAND_SRAM_REF 	UMEM_ALIAS
 #define BITBAND_SRAM_BASE 	0x22000000
@@ -50,6 +54,54 @@
 
 static unsigned int cmd_wake_sources;
 
+/*
+ * DS_COUNT_DEFAULT is a worst case crystal startup time, used until the
+ * startup has been characterized. The first deepsleeps that leave the
+ * count to us are probes at DS_COUNT_MIN: the wake waits for MOSC to
+ * settle before anything runs from it, and the startup is the count
+ * plus the settling time. The count is then that plus a guard band.
+ */
+#define DS_COUNT_MIN		0x0400	/* Probe count, floor for A8 values */
+#define DS_COUNT_MAX		0xffff
+#define DS_COUNT_GUARD		25	/* Default guard band, % */
+#define DS_COUNT_GUARD_MAX	100
+#define DS_COUNT_PROBES		3	/* Stable probes proving DS_COUNT_MIN */
+
+#define MOSC_SAMPLE_TICKS	2	/* 32K ticks per MOSC frequency sample */
+#define MOSC_SAMPLE_MAX		64	/* Longer than DS_COUNT_DEFAULT takes */
+#define MOSC_SAMPLE_TOL		64	/* Settled once samples agree to 1/64 */
+
+static struct {
+	unsigned short applied;		/* Used when the A8 leaves it to us */
+	unsigned short safe;		/* Lowest count accepted from the A8 */
+	unsigned short programmed;	/* Used for the current sleep */
+	unsigned int measured;		/* Crystal startup, MOSC cycles */
+	unsigned int guard;		/* Added to measured, % */
+	unsigned int probes;		/* Probe wakes left before giving up */
+	bool probing;			/* The current sleep is a probe */
+} ds_count = {
+	.applied	= DS_COUNT_DEFAULT,
+	.safe		= DS_COUNT_DEFAULT,
+	.programmed	= DS_COUNT_DEFAULT,
+	.guard		= DS_COUNT_GUARD,
+	.probes		= DS_COUNT_PROBES,
+};
+
+/* DPLLs bypassed across DDR self-refresh, relocked in reverse order */
+static const enum dpll_id ds_bypass_plls[] = {
+	DPLL_CORE,
+	DPLL_DDR,
+	DPLL_DISP,
+	DPLL_PER,
+	DPLL_MPU,
+	DPLL_END,
+};
+
+/* DPLLs left in bypass by ds_restore_critical() */
+static enum dpll_id ds_deferred_plls[DPLL_COUNT + 1] = {
+	DPLL_END,
+};
+
 unsigned int soc_id;
 unsigned int soc_rev;
 unsigned int soc_type;
@@ -79,6 +131,10 @@ void setup_soc(void)
 	powerdomain_init();
 	dpll_init();
 	ldo_init();
+
+	counter32k_init();
+	timebase_init();
+	ds_count_publish();
 }
 
 /* DeepSleep related */
@@ -86,6 +142,8 @@ int disable_master_oscillator(void)
 {
 	unsigned int v = __raw_readl(DEEPSLEEP_CTRL);
 
+	journal_push(JOURNAL_MOSC, 0);
+
 	v = var_mod(v, DS_ENABLE_MASK, (1 << DS_ENABLE_SHIFT));
 
 	__raw_writel(v, DEEPSLEEP_CTRL);
@@ -113,6 +171,147 @@ void configure_deepsleep_count(int ds_count)
 	__raw_writel(v, DEEPSLEEP_CTRL);
 }
 
+/* CUST_REG: [31:16] lowest accepted count, [15:0] count used by default */
+void ds_count_publish(void)
+{
+	msg_write(ds_count.safe << 16 | ds_count.applied, CUST_REG);
+}
+
+/*
+ * Pick the deepsleep count for this sleep. A8 values below what has
+ * been found safe are raised, 0 or DS_COUNT_DEFAULT mean the A8 has no
+ * better idea than the tuned count. Those sleeps probe the startup
+ * until it is known.
+ */
+unsigned int ds_count_select(unsigned int requested)
+{
+	unsigned int count;
+
+	ds_count.probing = false;
+
+	if (requested && requested != DS_COUNT_DEFAULT) {
+		count = max(requested, ds_count.safe);
+	} else if (!ds_count.measured && ds_count.probes && dwt_enable()) {
+		count = DS_COUNT_MIN;
+		ds_count.probing = true;
+	} else {
+		count = ds_count.applied;
+	}
+
+	ds_count.programmed = count;
+
+	return count;
+}
+
+/* Time the PRCM holds the wakeup for with the default count */
+unsigned int ds_count_us(void)
+{
+	return ds_count.applied * 1000 / get_master_xtal_khz();
+}
+
+/* DWT cycles over one sample period, starting on a 32K edge */
+static unsigned int mosc_sample(void)
+{
+	unsigned int start;
+
+	counter32k_wait(1);
+	start = dwt_cycles();
+	counter32k_wait(MOSC_SAMPLE_TICKS);
+
+	return dwt_cycles() - start;
+}
+
+/*
+ * Number of 32K ticks MOSC kept drifting after deepsleep exit, 0 if it
+ * was stable right away, -1 if it cannot be measured or never settled.
+ * With the DPLLs in bypass the CM3 clock follows MOSC, so compare
+ * successive DWT counts against the free running 32K counter.
+ */
+static int mosc_settle_ticks(void)
+{
+	unsigned int prev;
+	unsigned int cur;
+	unsigned int delta;
+	int i;
+
+	if (!dwt_enable())
+		return -1;
+
+	prev = mosc_sample();
+	for (i = 0; i < MOSC_SAMPLE_MAX; i++) {
+		cur = mosc_sample();
+		delta = cur > prev ? cur - prev : prev - cur;
+		if (delta <= prev / MOSC_SAMPLE_TOL)
+			break;
+		prev = cur;
+	}
+
+	if (i == MOSC_SAMPLE_MAX)
+		return -1;
+
+	return i * MOSC_SAMPLE_TICKS;
+}
+
+/* Counts from the measured startup plus the guard */
+static void ds_count_update(void)
+{
+	unsigned int need;
+
+	if (!ds_count.measured)
+		return;
+
+	need = ds_count.measured * (100 + ds_count.guard) / 100;
+	need = min(max(need, DS_COUNT_MIN), DS_COUNT_MAX);
+
+	ds_count.safe = need;
+	ds_count.applied = need;
+}
+
+/* A guard band of 0 uses the measured startup as is */
+int ds_count_configure(unsigned int guard)
+{
+	if (guard > DS_COUNT_GUARD_MAX)
+		return -1;
+
+	ds_count.guard = guard;
+	ds_count_update();
+	ds_count_publish();
+
+	return 0;
+}
+
+/*
+ * Called on exit from a deepsleep that had MOSC turned off, returns
+ * right away unless the sleep was a probe. A probe wake may come before
+ * MOSC ever stopped, so only DS_COUNT_PROBES stable ones in a row prove
+ * DS_COUNT_MIN is enough. The settling time is in ticks of the 32K RC
+ * oscillator, so it goes through the calibrated tick period.
+ */
+void ds_count_tune(void)
+{
+	int settle;
+
+	if (!ds_count.probing)
+		return;
+
+	ds_count.probing = false;
+	settle = mosc_settle_ticks();
+
+	if (settle < 0) {
+		/* Keep DS_COUNT_DEFAULT */
+		ds_count.probes = 0;
+		return;
+	}
+
+	if (!settle && --ds_count.probes)
+		return;
+
+	ds_count.measured = ds_count.programmed + timebase_ticks_to_us(settle) *
+						get_master_xtal_khz() / 1000;
+	ds_count_update();
+	ds_count_publish();
+}
+
 /*
  * A8 is expected to have left the module in a state where it will
  * cause a wakeup event. Ideally, this function should just enable
@@ -120,6 +319,8 @@ void configure_deepsleep_count(int ds_count)
  */
 void configure_wake_sources(int wake_sources)
 {
+	journal_push(JOURNAL_WAKE_SOURCES, 0);
+
 	cmd_wake_sources = wake_sources;
 
 	/* Enable wakeup interrupts from required wake sources */
@@ -173,6 +374,9 @@ void configure_wake_sources(int wake_sources)
 
 	if (soc_id == AM43XX_SOC_ID)
 		nvic_enable_irq(CM3_IRQ_TPM_WAKE);
+
+	/* Deadlines queued by the A8 wake from any state */
+	wake_timer_arm();
 }
 
 void clear_wake_sources(void)
@@ -203,11 +407,17 @@ void clear_wake_sources(void)
 	if (soc_id == AM43XX_SOC_ID)
 		nvic_disable_irq(CM3_IRQ_TPM_WAKE);
 
+	wake_timer_disarm();
+
 	/* TODO: Clear all the pending interrupts */
 }
 
+/* Undone as a whole by ds_restore() */
 void ds_save(void)
 {
+	journal_push(JOURNAL_DDR, 0);
+	journal_hold();
+
 	set_ddr_reset();
 
 	ddr_io_suspend();
@@ -220,20 +430,14 @@ void ds_save(void)
 
 	ldo_power_down(LDO_MPU);
 
-	pll_bypass(DPLL_CORE);
-	pll_bypass(DPLL_DDR);
-	pll_bypass(DPLL_DISP);
-	pll_bypass(DPLL_PER);
-	pll_bypass(DPLL_MPU);
+	plls_bypass(ds_bypass_plls);
+
+	journal_release();
 }
 
-void ds_restore(void)
+static void _ds_restore(const enum dpll_id *plls)
 {
-	pll_lock(DPLL_MPU);
-	pll_lock(DPLL_PER);
-	pll_lock(DPLL_DISP);
-	pll_lock(DPLL_DDR);
-	pll_lock(DPLL_CORE);
+	plls_lock(plls);
 
 	ldo_power_up(LDO_MPU);
 
@@ -252,17 +456,120 @@ void ds_restore(void)
 		clear_ddr_reset();
 }
 
+void ds_restore(void)
+{
+	_ds_restore(ds_bypass_plls);
+}
+
+/*
+ * Same as ds_restore(), but DPLLs in defer_mask stay in bypass until
+ * ds_restore_deferred() so the MPU can be released without them.
+ */
+void ds_restore_critical(unsigned int defer_mask)
+{
+	enum dpll_id plls[DPLL_COUNT + 1];
+	int n = 0;
+	int d = 0;
+	int i;
+
+	for (i = 0; ds_bypass_plls[i] != DPLL_END; i++) {
+		if (defer_mask & (1 << ds_bypass_plls[i]))
+			ds_deferred_plls[d++] = ds_bypass_plls[i];
+		else
+			plls[n++] = ds_bypass_plls[i];
+	}
+	plls[n] = DPLL_END;
+	ds_deferred_plls[d] = DPLL_END;
+
+	_ds_restore(plls);
+}
+
+void ds_restore_deferred(void)
+{
+	plls_lock(ds_deferred_plls);
+	ds_deferred_plls[0] = DPLL_END;
+}
+
+/*
+ * Last sleep script sent through a8_i2c_sleep_cached_handler(). Any
+ * other script run since may have undone it, so that drops the cache.
+ */
+static struct {
+	unsigned short offset;
+	unsigned int sum;
+} i2c_sleep_cache = {
+	.offset	= 0xffff,
+};
+
+/* Checksum of an I2C0 sequence, speed and all transfers */
+static unsigned int i2c_sequence_sum(const unsigned char *sequence)
+{
+	unsigned int sum = sequence[0] | sequence[1] << 8;
+	unsigned int n;
+
+	sequence += 2;
+	while (*sequence) {
+		/* Length, target address, then the data bytes */
+		for (n = *sequence + 2; n; n--)
+			sum = (sum << 1 | sum >> 31) + *sequence++;
+	}
+
+	return sum;
+}
+
+/* Run an I2C0 sequence, keeping the I2C0 hwmod in its current state */
+int pm_i2c_write(const unsigned char *sequence)
+{
+	bool was_enabled = hwmod_is_enabled(HWMOD_I2C0);
+	int ret;
+
+	i2c_sleep_cache.offset = 0xffff;
+
+	journal_hold();
+	hwmod_enable(HWMOD_I2C0);
+	ret = i2c_write(sequence);
+	if (!was_enabled)
+		hwmod_disable(HWMOD_I2C0);
+	journal_release();
+
+	return ret;
+}
+
 int a8_i2c_sleep_handler(unsigned short i2c_sleep_offset)
 {
 	unsigned char *dmem = (unsigned char *) DMEM_BASE;
 	int ret = 0;
 
 	if (i2c_sleep_offset != 0xffff) {
-		bool was_enabled = hwmod_is_enabled(HWMOD_I2C0);
-		hwmod_enable(HWMOD_I2C0);
-		ret = i2c_write(dmem + i2c_sleep_offset);
-		if (!was_enabled)
-			hwmod_disable(HWMOD_I2C0);
+		journal_push(JOURNAL_I2C_SLEEP, 0);
+		ret = pm_i2c_write(dmem + i2c_sleep_offset);
+	}
+
+	return ret;
+}
+
+/*
+ * Sleep script whose settings the PMIC keeps until it powers off. It is
+ * only sent again if it changed or another script has run since.
+ */
+int a8_i2c_sleep_cached_handler(unsigned short i2c_sleep_offset)
+{
+	unsigned char *dmem = (unsigned char *) DMEM_BASE;
+	unsigned int sum;
+	int ret;
+
+	if (i2c_sleep_offset == 0xffff)
+		return 0;
+
+	sum = i2c_sequence_sum(dmem + i2c_sleep_offset);
+	if (i2c_sleep_cache.offset == i2c_sleep_offset &&
+						i2c_sleep_cache.sum == sum)
+		return 0;
+
+	ret = a8_i2c_sleep_handler(i2c_sleep_offset);
+	if (!ret) {
+		i2c_sleep_cache.offset = i2c_sleep_offset;
+		i2c_sleep_cache.sum = sum;
 	}
 
 	return ret;
@@ -273,13 +580,8 @@ int a8_i2c_wake_handler(unsigned short i2c_wake_offset)
 	unsigned char *dmem = (unsigned char *) DMEM_BASE;
 	int ret = 0;
 
-	if (i2c_wake_offset != 0xffff) {
-		bool was_enabled = hwmod_is_enabled(HWMOD_I2C0);
-		hwmod_enable(HWMOD_I2C0);
-		ret = i2c_write(dmem + i2c_wake_offset);
-		if (!was_enabled)
-			hwmod_disable(HWMOD_I2C0);
-	}
+	if (i2c_wake_offset != 0xffff)
+		ret = pm_i2c_write(dmem + i2c_wake_offset);
 
 	return ret;
 }
@@ -0,0 +1,141 @@
+/*
+ * AM33XX-CM3 firmware
+ *
+ * Cortex-M3 (CM3) firmware for power management on Texas Instruments' AM33XX series of SoCs
+ *
+ * Copyright (C) 2011 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  This software is licensed under the  standard terms and conditions in the Texas Instruments  Incorporated
+ *  Technology and Software Publicly Available Software License Agreement , a copy of which is included in the
+ *  software download.
+*/
+
+
+#include <stddef.h>
+#include <cm3.h>
+#include <device_cm3.h>
+#include <msg.h>
+#include <prcm_core.h>
+#include <clockdomain.h>
+#include <powerdomain.h>
+#include <dpll.h>
+#include <counter32k.h>
+#include <journal.h>
+#include <promote.h>
+
+static unsigned int threshold_ticks;
+static enum promote_level max_level;
+
+static bool active;
+static enum promote_level level;
+static struct deep_sleep_data idle_data;
+
+/* A threshold of 0 turns promotion off */
+int promote_configure(unsigned int ms, unsigned int max)
+{
+	if (ms > PROMOTE_MAX_MS || max >= PROMOTE_COUNT)
+		return -1;
+
+	promote_stop();
+
+	threshold_ticks = ms * 32768 / 1000;
+	max_level = ms ? max : PROMOTE_NONE;
+
+	return 0;
+}
+
+/* Called once the cpuidle entry has been committed */
+void promote_start(struct deep_sleep_data *data)
+{
+	level = PROMOTE_NONE;
+
+	if (max_level == PROMOTE_NONE || !threshold_ticks)
+		return;
+
+	idle_data = *data;
+	active = true;
+
+	nvic_clear_irq(CM3_IRQ_TINT0);
+	nvic_enable_irq(CM3_IRQ_TINT0);
+	counter32k_alarm(threshold_ticks);
+}
+
+/* The wake claim stops promotion, the level reached is kept for the wake */
+void promote_stop(void)
+{
+	if (!active)
+		return;
+
+	active = false;
+
+	counter32k_alarm_cancel();
+	nvic_disable_irq(CM3_IRQ_TINT0);
+	nvic_clear_irq(CM3_IRQ_TINT0);
+}
+
+enum promote_level promote_reached(void)
+{
+	return level;
+}
+
+static void promote_per_ret(void)
+{
+	struct deep_sleep_data ret = idle_data;
+
+	ret.pd_per_state = PD_RET;
+	ret.pd_per_icss_mem_ret_state = 1;
+	ret.pd_per_mem_ret_state = 1;
+	ret.pd_per_ocmc_ret_state = 1;
+	ret.pd_per_ocmc2_ret_state = 1;
+
+	/* Only takes effect once every PER module has idled */
+	pd_state_change(get_pd_per_stctrl_val(&ret), PD_PER);
+}
+
+static void promote_step(enum promote_level next)
+{
+	switch (next) {
+	case PROMOTE_CLKDMS:
+		clkdms_sleep_deferred();
+		break;
+	case PROMOTE_PER_RET:
+		promote_per_ret();
+		break;
+	case PROMOTE_PLLS:
+		pll_bypass(DPLL_DISP);
+		break;
+	case PROMOTE_MOSC:
+		configure_deepsleep_count(ds_count_select(0));
+		disable_master_oscillator();
+		break;
+	default:
+		break;
+	}
+}
+
+/*
+ * TINT0: the idle threshold expired without a wake, go one level deeper.
+ * Wake interrupts are held off so a wake never sees a step half done.
+ */
+void promote_irq_handler(void)
+{
+	__asm("cpsid i");
+
+	counter32k_alarm_cancel();
+	nvic_clear_irq(CM3_IRQ_TINT0);
+
+	if (active) {
+		level++;
+
+		journal_resume();
+		promote_step(level);
+		journal_close();
+
+		if (level < max_level)
+			counter32k_alarm(threshold_ticks);
+		else
+			promote_stop();
+	}
+
+	__asm("cpsie i");
+}
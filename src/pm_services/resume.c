@@ -0,0 +1,90 @@
+/*
+ * AM33XX-CM3 firmware
+ *
+ * Cortex-M3 (CM3) firmware for power management on Texas Instruments' AM33XX series of SoCs
+ *
+ * Copyright (C) 2011 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  This software is licensed under the  standard terms and conditions in the Texas Instruments  Incorporated
+ *  Technology and Software Publicly Available Software License Agreement , a copy of which is included in the
+ *  software download.
+*/
+
+#include <stddef.h>
+#include <dpll.h>
+#include <ldo.h>
+#include <resume.h>
+
+/*
+ * A resume stage kicks off some analog settling (LDO ramp, DPLL power
+ * switch) and reports when it is over. Stages only wait on the stages
+ * listed in deps, everything else runs in parallel.
+ */
+struct resume_stage {
+	void (*start)(void);
+	bool (*done)(void);
+	unsigned int deps;
+};
+
+static void ldo_core_start(void)
+{
+	ldo_power_up(LDO_CORE);
+}
+
+static bool ldo_core_done(void)
+{
+	return ldo_is_on(LDO_CORE);
+}
+
+static const struct resume_stage resume_stages[RESUME_STAGE_COUNT] = {
+	[RESUME_LDO_CORE] = {
+		.start	= ldo_core_start,
+		.done	= ldo_core_done,
+	},
+	[RESUME_PLL_PON] = {
+		.start	= plls_pon_start,
+		.done	= plls_pon_done,
+	},
+	[RESUME_PLL_PGOOD] = {
+		.start	= plls_pgood_start,
+		.done	= plls_pgood_done,
+		.deps	= RESUME_STAGE(RESUME_PLL_PON),
+	},
+	[RESUME_PLL_RELEASE] = {
+		.start	= plls_power_up_finish,
+		.deps	= RESUME_STAGE(RESUME_PLL_PGOOD),
+	},
+};
+
+/*
+ * Start every requested stage as soon as its dependencies are met and
+ * return once all of them are done. Dependencies on stages that were
+ * not requested count as met.
+ */
+void resume_stages_run(unsigned int stages)
+{
+	unsigned int all = RESUME_STAGE(RESUME_STAGE_COUNT) - 1;
+	unsigned int done = ~stages & all;
+	unsigned int started = 0;
+	int i;
+
+	while (done != all) {
+		for (i = 0; i < RESUME_STAGE_COUNT; i++) {
+			const struct resume_stage *stage = &resume_stages[i];
+			unsigned int bit = RESUME_STAGE(i);
+
+			if (done & bit)
+				continue;
+
+			if (!(started & bit)) {
+				if ((stage->deps & done) != stage->deps)
+					continue;
+				stage->start();
+				started |= bit;
+			}
+
+			if (!stage->done || stage->done())
+				done |= bit;
+		}
+	}
+}
@@ -0,0 +1,223 @@
+/*
+ * AM33XX-CM3 firmware
+ *
+ * Cortex-M3 (CM3) firmware for power management on Texas Instruments' AM33XX series of SoCs
+ *
+ * Copyright (C) 2011 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  This software is licensed under the  standard terms and conditions in the Texas Instruments  Incorporated
+ *  Technology and Software Publicly Available Software License Agreement , a copy of which is included in the
+ *  software download.
+*/
+
+#include <stddef.h>
+#include <cm3.h>
+#include <device_cm3.h>
+#include <device_common.h>
+#include <io.h>
+#include <dpll.h>
+#include <hwmod.h>
+#include <pmic.h>
+#include <smartreflex.h>
+
+#define SRCONFIG			0x00
+#define NVALUERECIPROCAL		0x1c
+#define IRQSTATUS			0x28
+#define IRQENABLE_SET			0x2c
+#define IRQENABLE_CLR			0x30
+#define SENERROR_V2			0x34
+#define ERRCONFIG_V2			0x38
+
+/* SRCONFIG bit-fields */
+#define SRCONFIG_ACCUMDATA_SHIFT	22
+#define SRCONFIG_SRCLKLENGTH_SHIFT	12
+#define SRCONFIG_SRENABLE		(1 << 11)
+#define SRCONFIG_SENENABLE		(1 << 10)
+#define SRCONFIG_ERRGEN_EN		(1 << 9)
+#define SRCONFIG_SENNENABLE		(1 << 1)
+#define SRCONFIG_SENPENABLE		(1 << 0)
+
+/* ERRCONFIG_V2 bit-fields */
+#define ERRCONFIG_ERRWEIGHT_SHIFT	16
+#define ERRCONFIG_ERRWEIGHT_MASK	(0x7 << 16)
+
+/* IRQSTATUS/IRQENABLE bit-fields */
+#define IRQ_MCUACCUMINT			(1 << 3)
+
+/* SENERROR_V2 bit-fields */
+#define SENERROR_AVGERROR_SHIFT		8
+#define SENERROR_AVGERROR_MASK		(0xff << 8)
+
+struct sr_data {
+	unsigned int base;
+	enum hwmod_id hwmod;
+	int irq;
+	bool enabled;
+	struct sr_cfg cfg;
+};
+
+static struct sr_data srs[VDD_COUNT] = {
+	[VDD_MPU] = {
+		.base	= SR1_BASE,
+		.hwmod	= HWMOD_SMARTREFLEX1,
+		.irq	= CM3_IRQ_SMRFLX_MPU,
+	},
+	[VDD_CORE] = {
+		.base	= SR0_BASE,
+		.hwmod	= HWMOD_SMARTREFLEX0,
+		.irq	= CM3_IRQ_SMRFLX_CORE,
+	},
+};
+
+static void sr_write(struct sr_data *sr, unsigned int val, int reg)
+{
+	__raw_writel(val, sr->base + reg);
+}
+
+static unsigned int sr_read(struct sr_data *sr, int reg)
+{
+	return __raw_readl(sr->base + reg);
+}
+
+static void sr_start(struct sr_data *sr)
+{
+	/* SR clock of ~200KHz, same scaling as the kernel driver */
+	unsigned int clk_length = get_master_xtal_khz() * 5 / 1000;
+
+	sr_write(sr, 0, SRCONFIG);
+	sr_write(sr, sr->cfg.nvalue, NVALUERECIPROCAL);
+	sr_write(sr, var_mod(sr_read(sr, ERRCONFIG_V2), ERRCONFIG_ERRWEIGHT_MASK,
+		sr->cfg.errweight << ERRCONFIG_ERRWEIGHT_SHIFT), ERRCONFIG_V2);
+
+	sr_write(sr, 0xffffffff, IRQSTATUS);
+	sr_write(sr, IRQ_MCUACCUMINT, IRQENABLE_SET);
+
+	sr_write(sr, (sr->cfg.accumdata << SRCONFIG_ACCUMDATA_SHIFT) |
+		(clk_length << SRCONFIG_SRCLKLENGTH_SHIFT) |
+		SRCONFIG_SRENABLE | SRCONFIG_SENENABLE | SRCONFIG_ERRGEN_EN |
+		SRCONFIG_SENNENABLE | SRCONFIG_SENPENABLE, SRCONFIG);
+
+	nvic_clear_irq(sr->irq);
+	nvic_enable_irq(sr->irq);
+}
+
+static void sr_stop(struct sr_data *sr)
+{
+	nvic_disable_irq(sr->irq);
+
+	sr_write(sr, IRQ_MCUACCUMINT, IRQENABLE_CLR);
+	sr_write(sr, 0, SRCONFIG);
+	sr_write(sr, 0xffffffff, IRQSTATUS);
+
+	nvic_clear_irq(sr->irq);
+}
+
+int sr_enable(enum vdd_id id, const struct sr_cfg *cfg)
+{
+	struct sr_data *sr = &srs[id];
+
+	if (!pmic_vdd_valid(id) || !cfg->nvalue ||
+	    cfg->vsel_floor > cfg->vsel_nom)
+		return -1;
+
+	if (sr->enabled)
+		sr_stop(sr);
+
+	sr->cfg = *cfg;
+	sr->enabled = true;
+
+	hwmod_enable(sr->hwmod);
+	sr_start(sr);
+
+	return 0;
+}
+
+void sr_disable(enum vdd_id id)
+{
+	struct sr_data *sr = &srs[id];
+
+	if (!sr->enabled)
+		return;
+
+	sr_stop(sr);
+	hwmod_disable(sr->hwmod);
+	sr->enabled = false;
+}
+
+void sr_reset(void)
+{
+	int i;
+
+	for (i = 0; i < VDD_COUNT; i++)
+		sr_disable(i);
+}
+
+/*
+ * Stop sampling across low power transitions, and gate the modules so
+ * that they do not keep the WKUP clockdomain busy while asleep
+ */
+void sr_suspend(void)
+{
+	int i;
+
+	for (i = 0; i < VDD_COUNT; i++) {
+		if (!srs[i].enabled)
+			continue;
+
+		sr_stop(&srs[i]);
+		hwmod_disable(srs[i].hwmod);
+	}
+}
+
+/*
+ * If the A8 wake sequence ran, the rails are back at their nominal OPP
+ * voltage, so program the last AVS voltage again before restarting.
+ */
+void sr_resume(bool resync)
+{
+	int i;
+
+	for (i = 0; i < VDD_COUNT; i++) {
+		if (!srs[i].enabled)
+			continue;
+
+		hwmod_enable(srs[i].hwmod);
+
+		if (resync)
+			pmic_vdd_set_vsel(i, pmic_vdd_get_vsel(i));
+
+		sr_start(&srs[i]);
+	}
+}
+
+/*
+ * One AVS iteration: step the rail by a single PMIC selector in the
+ * direction of the averaged sensor error. A positive error means the
+ * silicon runs faster than the target and the voltage can go down.
+ */
+void sr_irq_handler(enum vdd_id id)
+{
+	struct sr_data *sr = &srs[id];
+	unsigned int status;
+	unsigned int vsel;
+	signed char err;
+
+	status = sr_read(sr, IRQSTATUS);
+	sr_write(sr, status, IRQSTATUS);
+
+	if (!sr->enabled || !(status & IRQ_MCUACCUMINT))
+		return;
+
+	err = (sr_read(sr, SENERROR_V2) & SENERROR_AVGERROR_MASK) >>
+						SENERROR_AVGERROR_SHIFT;
+	vsel = pmic_vdd_get_vsel(id);
+
+	if (err > sr->cfg.err_max && vsel > sr->cfg.vsel_floor)
+		vsel--;
+	else if (err < sr->cfg.err_min && vsel < sr->cfg.vsel_nom)
+		vsel++;
+	else
+		return;
+
+	pmic_vdd_set_vsel(id, vsel);
+}
@@ -0,0 +1,203 @@
+/*
+ * AM33XX-CM3 firmware
+ *
+ * Cortex-M3 (CM3) firmware for power management on Texas Instruments' AM33XX series of SoCs
+ *
+ * Copyright (C) 2011 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  This software is licensed under the  standard terms and conditions in the Texas Instruments  Incorporated
+ *  Technology and Software Publicly Available Software License Agreement , a copy of which is included in the
+ *  software download.
+*/
+
+#include <stddef.h>
+#include <prcm_core.h>
+#include <msg.h>
+#include <counter32k.h>
+#include <timebase.h>
+#include <state_select.h>
+
+/*
+ * Latencies of the states CMD_ID_AUTO picks from, deepest first. All of
+ * them are V2 states, the CM3 takes care of DDR self-refresh.
+ *
+ * Both latencies start as conservative guesses and are replaced by the
+ * worst case measured once the state has been used: entry from the A8
+ * WFI trigger to the end of the command handler, exit from CM3 wakeup
+ * to MPU release. The PRCM deepsleep count is added on top of the exit
+ * latency for MOSC off states.
+ */
+struct state_latency {
+	enum cmd_ids cmd_id;
+	unsigned short entry_us;
+	unsigned short exit_us;
+	bool entry_measured;
+	bool exit_measured;
+};
+
+static struct state_latency states[] = {
+	{ .cmd_id = CMD_ID_DS0_V2,	.entry_us = 1000, .exit_us = 5000 },
+	{ .cmd_id = CMD_ID_DS1_V2,	.entry_us = 800, .exit_us = 3000 },
+	{ .cmd_id = CMD_ID_DS2_V2,	.entry_us = 600, .exit_us = 2000 },
+	{ .cmd_id = CMD_ID_STANDBY_V2,	.entry_us = 400, .exit_us = 1000 },
+};
+
+#define STATE_COUNT	(sizeof(states) / sizeof(states[0]))
+
+/*
+ * Entry plus exit of CMD_ID_CPUIDLE_V2, mostly the MPU DPLL bypass and
+ * relock. Idles predicted to be shorter than this skip the bypass.
+ */
+static struct state_latency cpuidle_v2 = {
+	.cmd_id = CMD_ID_CPUIDLE_V2, .entry_us = 100, .exit_us = 300,
+};
+
+/*
+ * Recent cpuidle durations per wake IRQ, saturated at 0xffff us. The
+ * next idle is predicted from the history of the last wake source.
+ */
+#define IDLE_HISTORY		4
+#define IDLE_WAKE_IRQ_BASE	32
+#define IDLE_WAKE_IRQS		32
+
+static struct {
+	unsigned short us[IDLE_HISTORY];
+	unsigned char next;
+	unsigned char count;
+} idle_history[IDLE_WAKE_IRQS];
+
+static int idle_last_irq = -1;
+static unsigned int idle_start;
+
+static union state_data *state_data(enum cmd_ids id)
+{
+	if (soc_type != SOC_TYPE_GP && cmd_handlers[id].hs_data)
+		return cmd_handlers[id].hs_data;
+
+	return cmd_handlers[id].gp_data;
+}
+
+static unsigned int state_exit_us(struct state_latency *state)
+{
+	unsigned int us = state->exit_us;
+
+	if (state_data(state->cmd_id)->deep_sleep.mosc_state == MOSC_OFF)
+		us += ds_count_us();
+
+	return us;
+}
+
+/*
+ * CMD_ID_AUTO, PARAM1: maximum exit latency in us
+ *              PARAM2: expected idle duration in us
+ *
+ * Replaces the command with the deepest state whose exit latency fits
+ * the budget and whose entry plus exit fits the idle time, so the rest
+ * of the command flow is the one of the chosen state. The chosen ID is
+ * reported back in the CMD_ID field of STAT_ID_REG, CMD_ID_INVALID if
+ * nothing fits and the command fails.
+ */
+void state_select_cmd(void)
+{
+	unsigned int max_exit_us = msg_read(PARAM1_REG);
+	unsigned int idle_us = msg_read(PARAM2_REG);
+	enum cmd_ids id = CMD_ID_INVALID;
+	unsigned int exit_us;
+	int i;
+
+	for (i = 0; i < STATE_COUNT; i++) {
+		exit_us = state_exit_us(&states[i]);
+
+		if (exit_us <= max_exit_us &&
+		    states[i].entry_us + exit_us <= idle_us) {
+			id = states[i].cmd_id;
+			break;
+		}
+	}
+
+	/* Let the chosen state run with its default parameters */
+	msg_write(DS_IPC_DEFAULT, PARAM1_REG);
+	msg_write(DS_IPC_DEFAULT, PARAM2_REG);
+
+	cmd_global_data.cmd_id = id;
+	msg_cmd_id_update(id);
+}
+
+static struct state_latency *state_find(enum cmd_ids id)
+{
+	int i;
+
+	for (i = 0; i < STATE_COUNT; i++)
+		if (states[i].cmd_id == id)
+			return &states[i];
+
+	if (id == CMD_ID_CPUIDLE_V2)
+		return &cpuidle_v2;
+
+	return NULL;
+}
+
+void state_entry_latency_update(enum cmd_ids id, unsigned int us)
+{
+	struct state_latency *state = state_find(id);
+
+	if (!state)
+		return;
+
+	if (!state->entry_measured || us > state->entry_us)
+		state->entry_us = min(us, 0xffff);
+	state->entry_measured = true;
+}
+
+void state_exit_latency_update(enum cmd_ids id, unsigned int us)
+{
+	struct state_latency *state = state_find(id);
+
+	if (!state)
+		return;
+
+	if (!state->exit_measured || us > state->exit_us)
+		state->exit_us = min(us, 0xffff);
+	state->exit_measured = true;
+}
+
+/* Called once the cpuidle entry is committed */
+void state_idle_start(void)
+{
+	idle_start = counter32k_read();
+}
+
+void state_idle_end(int wake_irq)
+{
+	unsigned int us = timebase_ticks_to_us(counter32k_read() - idle_start);
+	int irq = wake_irq - IDLE_WAKE_IRQ_BASE;
+
+	if (irq < 0 || irq >= IDLE_WAKE_IRQS)
+		return;
+
+	idle_history[irq].us[idle_history[irq].next] = min(us, 0xffff);
+	idle_history[irq].next = (idle_history[irq].next + 1) % IDLE_HISTORY;
+	if (idle_history[irq].count < IDLE_HISTORY)
+		idle_history[irq].count++;
+
+	idle_last_irq = irq;
+}
+
+/*
+ * True if the next cpuidle is expected to end before the MPU DPLL
+ * bypass pays off. Without any history the idle is assumed long.
+ */
+bool state_idle_short(void)
+{
+	unsigned int total = 0;
+	int i;
+
+	if (idle_last_irq < 0 || !idle_history[idle_last_irq].count)
+		return false;
+
+	for (i = 0; i < idle_history[idle_last_irq].count; i++)
+		total += idle_history[idle_last_irq].us[i];
+
+	return total / idle_history[idle_last_irq].count <
+			cpuidle_v2.entry_us + cpuidle_v2.exit_us;
+}
@@ -0,0 +1,69 @@
+/*
+ * AM33XX-CM3 firmware
+ *
+ * Cortex-M3 (CM3) firmware for power management on Texas Instruments' AM33XX series of SoCs
+ *
+ * Copyright (C) 2011 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  This software is licensed under the  standard terms and conditions in the Texas Instruments  Incorporated
+ *  Technology and Software Publicly Available Software License Agreement , a copy of which is included in the
+ *  software download.
+*/
+
+#include <stddef.h>
+#include <cm3.h>
+#include <device_common.h>
+#include <io.h>
+#include <clockdomain.h>
+#include <hwmod.h>
+#include <rtc.h>
+#include <wake_record.h>
+
+#define GPIO_IRQSTATUS_RAW_0	0x24
+#define GPIO_IRQSTATUS_RAW_1	0x28
+#define GPIO_IRQWAKEN_0		0x44
+#define GPIO_IRQWAKEN_1		0x48
+
+#define UART_SSR		0x44
+
+/*
+ * Only modules the A8 left enabled are looked at, accessing a module
+ * that is not clocked would fault. Reads are picked to have no side
+ * effects, the A8 drivers still handle their interrupts as usual.
+ */
+void wake_record_capture(struct wake_record *rec, int irq)
+{
+	unsigned int wake;
+
+	rec->count++;
+	rec->irq = irq;
+	rec->valid = 0;
+	rec->late = 0;
+
+	/* The IRQ being handled is active, no longer pending */
+	rec->pending[0] = __raw_readl(NVIC_IRQ_SET_PEND1);
+	rec->pending[1] = __raw_readl(NVIC_IRQ_SET_PEND2);
+	rec->pending[irq / 32] |= 1 << (irq % 32);
+
+	rec->gpio0 = 0;
+	if (hwmod_is_enabled(HWMOD_GPIO0)) {
+		wake = __raw_readl(GPIO0_BASE + GPIO_IRQWAKEN_0) |
+			__raw_readl(GPIO0_BASE + GPIO_IRQWAKEN_1);
+		rec->gpio0 = wake &
+			(__raw_readl(GPIO0_BASE + GPIO_IRQSTATUS_RAW_0) |
+			 __raw_readl(GPIO0_BASE + GPIO_IRQSTATUS_RAW_1));
+		rec->valid |= WAKE_REC_GPIO0;
+	}
+
+	rec->rtc = 0;
+	if (clkdm_active(CLKDM_RTC)) {
+		rec->rtc = rtc_reg_read(RTC_STATUS_REG);
+		rec->valid |= WAKE_REC_RTC;
+	}
+
+	rec->uart0 = 0;
+	if (hwmod_is_enabled(HWMOD_UART0)) {
+		rec->uart0 = __raw_readl(UART0_BASE + UART_SSR);
+		rec->valid |= WAKE_REC_UART0;
+	}
+}
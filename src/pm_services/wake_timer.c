@@ -0,0 +1,275 @@
+/*
+ * AM33XX-CM3 firmware
+ *
+ * Cortex-M3 (CM3) firmware for power management on Texas Instruments' AM33XX series of SoCs
+ *
+ * Copyright (C) 2011 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  This software is licensed under the  standard terms and conditions in the Texas Instruments  Incorporated
+ *  Technology and Software Publicly Available Software License Agreement , a copy of which is included in the
+ *  software download.
+*/
+
+
+#include <stddef.h>
+#include <cm3.h>
+#include <device_cm3.h>
+#include <device_common.h>
+#include <io.h>
+#include <prcm_core.h>
+#include <cm335x.h>
+#include <cm43xx.h>
+#include <clockdomain.h>
+#include <hwmod.h>
+#include <rtc.h>
+#include <timebase.h>
+#include <wake_timer.h>
+
+/* DMTIMER1_1MS has the older DMTIMER register layout */
+#define TIMER1_TISR		0x18
+#define TIMER1_TIER		0x1c
+#define TIMER1_TWER		0x20
+#define TIMER1_TCLR		0x24
+#define TIMER1_TCRR		0x28
+#define TIMER1_TWPS		0x34
+#define TIMER1_TMAR		0x38
+
+#define TIMER1_TCLR_ST		(1 << 0)
+#define TIMER1_TCLR_CE		(1 << 6)
+
+/* TISR, TIER and TWER bit-fields */
+#define TIMER1_IT_MAT		(1 << 0)
+
+/* CLKSEL_TIMER1MS_CLK values of the 32K sources */
+#define TIMER1MS_CLK_32KHZ	0x1
+#define TIMER1MS_CLK_RC32K	0x3
+#define TIMER1MS_CLK_32768	0x4
+
+/*
+ * The RTC is already running and costs nothing to use, but it only has
+ * a one second resolution and its alarm interrupt is shared with the
+ * kernel RTC driver, so it is only used where the A8 allows it. A
+ * relative RTC alarm of n seconds fires n - 1 to n seconds later, so it
+ * has to be set one second beyond the deadline and can be up to two
+ * seconds late.
+ */
+#define WAKE_TIMER_RTC_SLACK	2	/* Seconds */
+
+struct wake_timer {
+	unsigned int deadline;
+	unsigned int tolerance;		/* Ticks the wake may come late */
+	unsigned int id;
+	bool rtc;			/* The RTC alarm may be used */
+};
+
+/* Sorted by deadline */
+static struct wake_timer queue[WAKE_TIMER_QUEUE_LEN];
+static int queued;
+
+static enum {
+	WAKE_TIMER_NONE,
+	WAKE_TIMER_TIMER1,
+	WAKE_TIMER_RTC,
+} armed;
+
+/* Deadlines are compared relative to each other, the count wraps */
+static bool before(unsigned int a, unsigned int b)
+{
+	return (int) (a - b) < 0;
+}
+
+static void timer1_write(unsigned int val, int reg)
+{
+	/* The kernel may have left the timer in posted mode */
+	while (__raw_readl(DMTIMER1_BASE + TIMER1_TWPS));
+
+	__raw_writel(val, DMTIMER1_BASE + reg);
+}
+
+static unsigned int timer1_read(int reg)
+{
+	return __raw_readl(DMTIMER1_BASE + reg);
+}
+
+static unsigned int timer1_clksel(void)
+{
+	unsigned int clksel;
+
+	if (soc_id == AM335X_SOC_ID)
+		clksel = __raw_readl(AM335X_CLKSEL_TIMER1MS_CLK);
+	else
+		clksel = __raw_readl(AM43XX_CLKSEL_TIMER1MS_CLK);
+
+	return clksel & 0x7;
+}
+
+static bool timer1_usable(void)
+{
+	unsigned int clksel = timer1_clksel();
+
+	/* The master oscillator may be off by the time the deadline hits */
+	return clksel == TIMER1MS_CLK_32KHZ || clksel == TIMER1MS_CLK_RC32K ||
+					clksel == TIMER1MS_CLK_32768;
+}
+
+/* The RC oscillator can be far off 32768Hz, the timebase knows its rate */
+static unsigned int timer1_hz(void)
+{
+	if (timer1_clksel() == TIMER1MS_CLK_RC32K)
+		return timebase_tick_hz();
+
+	return WAKE_TIMER_HZ;
+}
+
+/* Deadlines are in the kernel's count, only a running timer has one */
+static bool timer1_running(void)
+{
+	if (!hwmod_is_enabled(HWMOD_TIMER1))
+		return false;
+
+	return timer1_read(TIMER1_TCLR) & TIMER1_TCLR_ST;
+}
+
+int wake_timer_add(unsigned int deadline, unsigned int tolerance_ms,
+						unsigned int id, bool rtc)
+{
+	unsigned int hz;
+	int i;
+
+	wake_timer_cancel(id);
+
+	if (queued == WAKE_TIMER_QUEUE_LEN || !timer1_running() ||
+	    !timer1_usable())
+		return -1;
+
+	hz = timer1_hz();
+
+	for (i = queued; i > 0 && before(deadline, queue[i - 1].deadline); i--)
+		queue[i] = queue[i - 1];
+
+	queue[i].deadline = deadline;
+	queue[i].tolerance = tolerance_ms / 1000 * hz +
+					tolerance_ms % 1000 * hz / 1000;
+	queue[i].id = id;
+	queue[i].rtc = rtc;
+	queued++;
+
+	return 0;
+}
+
+void wake_timer_cancel(unsigned int id)
+{
+	int i;
+
+	for (i = 0; i < queued; i++) {
+		if (queue[i].id == id) {
+			queued--;
+			for (; i < queued; i++)
+				queue[i] = queue[i + 1];
+			return;
+		}
+	}
+}
+
+/*
+ * One hardware wake serves every deadline from the head of the queue
+ * that can still be met without making an earlier one miss its
+ * tolerance. It happens at the latest of those deadlines, whatever is
+ * left of the tolerances is the slack for picking the timer. The RTC
+ * is only an option if all of those deadlines allow it.
+ */
+static unsigned int wake_timer_coalesce(unsigned int *slack, bool *rtc)
+{
+	unsigned int latest = queue[0].deadline + queue[0].tolerance;
+	unsigned int wake = queue[0].deadline;
+	int i;
+
+	*rtc = queue[0].rtc;
+
+	for (i = 1; i < queued && !before(latest, queue[i].deadline); i++) {
+		wake = queue[i].deadline;
+		if (before(wake + queue[i].tolerance, latest))
+			latest = wake + queue[i].tolerance;
+		*rtc = *rtc && queue[i].rtc;
+	}
+
+	*slack = latest - wake;
+
+	return wake;
+}
+
+/* Called with the wake sources of a low power entry */
+void wake_timer_arm(void)
+{
+	unsigned int wake;
+	unsigned int slack;
+	unsigned int now;
+	unsigned int secs;
+	unsigned int hz;
+	bool rtc;
+
+	armed = WAKE_TIMER_NONE;
+
+	if (!queued || !timer1_usable() || !timer1_running())
+		return;
+
+	now = timer1_read(TIMER1_TCRR);
+	wake = wake_timer_coalesce(&slack, &rtc);
+
+	/* Overdue, the A8 finds out from its own clock */
+	if (!before(now, wake))
+		return;
+
+	hz = timer1_hz();
+	if (rtc && slack >= WAKE_TIMER_RTC_SLACK * hz &&
+	    clkdm_active(CLKDM_RTC) && !rtc_alarm_busy()) {
+		secs = (wake - now) / hz + 2;
+		if (!rtc_alarm_set(secs, false)) {
+			nvic_enable_irq(CM3_IRQ_RTC_ALARM_WAKE);
+			armed = WAKE_TIMER_RTC;
+			return;
+		}
+	}
+
+	timer1_write(wake, TIMER1_TMAR);
+	timer1_write(TIMER1_IT_MAT, TIMER1_TISR);
+	timer1_write(timer1_read(TIMER1_TIER) | TIMER1_IT_MAT, TIMER1_TIER);
+	timer1_write(timer1_read(TIMER1_TWER) | TIMER1_IT_MAT, TIMER1_TWER);
+	timer1_write(timer1_read(TIMER1_TCLR) | TIMER1_TCLR_CE, TIMER1_TCLR);
+	nvic_enable_irq(CM3_IRQ_TIMER1_WAKE);
+	armed = WAKE_TIMER_TIMER1;
+}
+
+/* Called on wake, drops the deadlines that have passed */
+void wake_timer_disarm(void)
+{
+	unsigned int now;
+	int expired;
+	int i;
+
+	if (armed == WAKE_TIMER_TIMER1) {
+		timer1_write(timer1_read(TIMER1_TCLR) & ~TIMER1_TCLR_CE,
+								TIMER1_TCLR);
+		timer1_write(timer1_read(TIMER1_TWER) & ~TIMER1_IT_MAT,
+								TIMER1_TWER);
+		timer1_write(timer1_read(TIMER1_TIER) & ~TIMER1_IT_MAT,
+								TIMER1_TIER);
+		timer1_write(TIMER1_IT_MAT, TIMER1_TISR);
+	} else if (armed == WAKE_TIMER_RTC) {
+		rtc_alarm_clear();
+	}
+
+	armed = WAKE_TIMER_NONE;
+
+	if (!queued || !timer1_running())
+		return;
+
+	now = timer1_read(TIMER1_TCRR);
+	for (expired = 0; expired < queued; expired++)
+		if (before(now, queue[expired].deadline))
+			break;
+
+	queued -= expired;
+	for (i = 0; i < queued; i++)
+		queue[i] = queue[i + expired];
+}
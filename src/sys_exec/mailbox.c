@@ -0,0 +1,63 @@
+/*
+ * AM33XX-CM3 firmware
+ *
+ * Cortex-M3 (CM3) firmware for power management on Texas Instruments' AM33XX series of SoCs
+ *
+ * Copyright (C) 2011 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  This software is licensed under the  standard terms and conditions in the Texas Instruments  Incorporated
+ *  Technology and Software Publicly Available Software License Agreement , a copy of which is included in the
+ *  software download.
+*/
+
+#include <stddef.h>
+#include <device_common.h>
+#include <io.h>
+#include <hwmod.h>
+#include <mailbox.h>
+
+#define MAILBOX_MESSAGE(m)		(MAILBOX_BASE + 0x40 + 0x4 * (m))
+#define MAILBOX_FIFOSTATUS(m)		(MAILBOX_BASE + 0x80 + 0x4 * (m))
+
+#define MAILBOX_FIFOSTATUS_FULL		(1 << 0)
+
+static unsigned int fifo = MAILBOX_FIFO_NONE;
+static unsigned short seq;
+
+/* MAILBOX_FIFO_NONE stops posting, a new FIFO restarts the sequence */
+int mailbox_configure(unsigned int new_fifo)
+{
+	if (new_fifo >= MAILBOX_FIFO_COUNT && new_fifo != MAILBOX_FIFO_NONE)
+		return -1;
+
+	fifo = new_fifo;
+	seq = 0;
+
+	return 0;
+}
+
+/*
+ * Post a completion to the MPU. The mailbox is owned by the MPU, it is
+ * only written while the MPU keeps it clocked and never waited on; a
+ * full FIFO drops the message, which shows up as a sequence gap.
+ */
+void mailbox_post(unsigned int cmd_id, unsigned int stat)
+{
+	unsigned int msg;
+
+	if (fifo == MAILBOX_FIFO_NONE)
+		return;
+
+	msg = (seq++ << MAILBOX_MSG_SEQ_SHIFT) |
+		((stat << MAILBOX_MSG_STAT_SHIFT) & MAILBOX_MSG_STAT_MASK) |
+		(cmd_id & MAILBOX_MSG_CMD_MASK);
+
+	if (!hwmod_is_enabled(HWMOD_MAILBOX0))
+		return;
+
+	if (__raw_readl(MAILBOX_FIFOSTATUS(fifo)) &
+						MAILBOX_FIFOSTATUS_FULL)
+		return;
+
+	__raw_writel(msg, MAILBOX_MESSAGE(fifo));
+}
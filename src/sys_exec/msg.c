@@ -46,10 +46,19 @@ struct state_handler cmd_handlers[] = {
 	},
 	[CMD_ID_RTC_FAST] = {
 		.gp_data = &rtc_mode_data,
-		.cmd_handler = a8_lp_rtc_handler,
+		.prepare_handler = a8_rtc_fast_prepare_handler,
+		.cmd_handler = a8_lp_rtc_fast_handler,
 		.wake_handler = a8_wake_rtc_handler,
 		.needs_trigger = true,
 	},
+	[CMD_ID_RTC_DDR] = {
+		.gp_data = &rtc_mode_data,
+		.prepare_handler = a8_rtc_ddr_prepare_handler,
+		.cmd_handler = a8_lp_rtc_ddr_handler,
+		.wake_handler = a8_wake_rtc_handler,
+		.needs_trigger = true,
+		.do_ddr = true,
+	},
 	[CMD_ID_DS0] = {
 		.gp_data = &ds0_data,
 		.hs_data = &ds0_data_hs,
@@ -110,6 +119,12 @@ struct state_handler cmd_handlers[] = {
 		.needs_trigger = true,
 		.do_ddr = true,
 	},
+	[CMD_ID_STANDBY_RET] = {
+		.gp_data = &standby_ret_data,
+		.cmd_handler = a8_standby_handler,
+		.wake_handler = a8_wake_standby_handler,
+		.needs_trigger = true,
+	},
 	[CMD_ID_RESET] = {
 		.cmd_handler = a8_reset_handler,
 	},
@@ -128,6 +143,27 @@ struct state_handler cmd_handlers[] = {
 		.wake_handler = a8_wake_cpuidle_v2_handler,
 		.fast_trigger = true,
 	},
+	[CMD_ID_PMIC_CONFIG] = {
+		.cmd_handler = a8_pmic_config_handler,
+	},
+	[CMD_ID_AVS] = {
+		.cmd_handler = a8_avs_handler,
+	},
+	[CMD_ID_PROMOTE_CONFIG] = {
+		.cmd_handler = a8_promote_config_handler,
+	},
+	[CMD_ID_RTC_ALARM] = {
+		.cmd_handler = a8_rtc_alarm_handler,
+	},
+	[CMD_ID_WAKE_TIMER] = {
+		.cmd_handler = a8_wake_timer_handler,
+	},
+	[CMD_ID_DS_COUNT_CONFIG] = {
+		.cmd_handler = a8_ds_count_config_handler,
+	},
+	[CMD_ID_MAILBOX_CONFIG] = {
+		.cmd_handler = a8_mailbox_config_handler,
+	},
 };
 
 /* Read one specific IPC register */
@@ -164,8 +200,8 @@ bool msg_cmd_is_valid(void)
 	return cmd_handlers[cmd_global_data.cmd_id].cmd_handler != NULL;
 }
 
-/* Read all the IPC regs and pass it along to the appropriate handler */
-void msg_cmd_dispatcher(void)
+/* Read all the IPC regs into cmd_global_data */
+static void msg_cmd_read_params(void)
 {
 	int id;
 	unsigned int param1;
@@ -198,8 +234,31 @@ void msg_cmd_dispatcher(void)
 		custom_state_data.raw.param2 = param2;
 		cmd_global_data.data = &custom_state_data;
 	}
+}
+
+/*
+ * Let a command that needs a trigger do its work that does not depend
+ * on the A8 being in WFI as soon as it arrives. Returns non-zero if the
+ * command can not be entered.
+ */
+int msg_cmd_prepare(void)
+{
+	int id = cmd_global_data.cmd_id;
+
+	if (!cmd_handlers[id].prepare_handler)
+		return 0;
+
+	msg_cmd_read_params();
+
+	return cmd_handlers[id].prepare_handler(&cmd_global_data);
+}
 
-	cmd_handlers[id].cmd_handler(&cmd_global_data);
+/* Read all the IPC regs and pass it along to the appropriate handler */
+void msg_cmd_dispatcher(void)
+{
+	msg_cmd_read_params();
+
+	cmd_handlers[cmd_global_data.cmd_id].cmd_handler(&cmd_global_data);
 }
 
 void m3_param_reset(void)
@@ -230,6 +289,16 @@ void msg_cmd_stat_update(int cmd_stat_value)
 	msg_write(value, STAT_ID_REG);
 }
 
+void msg_cmd_id_update(int cmd_id)
+{
+	unsigned int value;
+
+	value = msg_read(STAT_ID_REG);
+	value &= 0xffff0000;
+	value |= cmd_id & 0xffff;
+	msg_write(value, STAT_ID_REG);
+}
+
 void msg_cmd_wakeup_reason_update(int wakeup_source)
 {
 	unsigned int value;
@@ -240,6 +309,30 @@ void msg_cmd_wakeup_reason_update(int wakeup_source)
 	msg_write(value, TRACE_REG);
 }
 
+void msg_resume_pending_update(bool pending)
+{
+	unsigned int value;
+
+	value = msg_read(TRACE_REG);
+	if (pending)
+		value |= TRACE_RESUME_PENDING;
+	else
+		value &= ~TRACE_RESUME_PENDING;
+	msg_write(value, TRACE_REG);
+}
+
+void msg_idle_shallow_update(bool shallow)
+{
+	unsigned int value;
+
+	value = msg_read(TRACE_REG);
+	if (shallow)
+		value |= TRACE_IDLE_SHALLOW;
+	else
+		value &= ~TRACE_IDLE_SHALLOW;
+	msg_write(value, TRACE_REG);
+}
+
 /*
  * Check whether command needs a trigger or not
  * returns true if trigger is needed
@@ -13,10 +13,23 @@
 #include <cm3.h>
 #include <device_cm3.h>
 #include <prcm_core.h>
+#include <dpll.h>
 #include <msg.h>
 #include <hwmod.h>
 #include <trace.h>
 #include <sync.h>
+#include <smartreflex.h>
+#include <pm_handlers.h>
+#include <telemetry.h>
+#include <mailbox.h>
+
+/*
+ * Time the last runs of each mailbox command took, decays slowly so an
+ * occasional slow run keeps the prediction on the safe side
+ */
+static unsigned short sync_predict_us[CMD_ID_COUNT];
+static unsigned int sync_cmd_id;
+static unsigned int sync_start;
 
 void a8_notify(int cmd_stat_value)
 {
@@ -46,23 +59,13 @@ void a8_m3_low_power_fast(int cmd_stat_value)
 
 void init_m3_state_machine(void)
 {
-	int i;
-
 	/* Flush out NVIC interrupts */
-	for (i = 0; i < CM3_NUM_EXT_INTERRUPTS; i++)
-	{
-		nvic_disable_irq(i);
-		nvic_clear_irq(i);
-	}
-
-	/* Tamper swakeup interrupt is new addition for AM43XX SOCx */
-	if (soc_id == AM43XX_SOC_ID) {
-		nvic_disable_irq(CM3_IRQ_TPM_WAKE);
-		nvic_clear_irq(CM3_IRQ_TPM_WAKE);
-	}
+	pm_nvic_flush();
 
 	trace_init();
 
+	sr_reset();
+
 	pm_reset();
 
 	/* Enable only the MBX IRQ */
@@ -78,8 +81,41 @@ void init_m3_state_machine(void)
 	a8_notify(CMD_STAT_PASS);
 }
 
-/* Timer based sync scheme - Not required for now */
+/*
+ * Timer based sync scheme: timer_sync_start() publishes when the CM3
+ * expects to be done with the mailbox command it just picked up, and
+ * timer_sync() records how long it took once the status is written.
+ * The A8 can sleep for the predicted time and check the record once
+ * instead of spinning on the IPC status register, or wait for the
+ * completion posted to its mailbox.
+ */
+void timer_sync_start(void)
+{
+	sync_cmd_id = cmd_global_data.cmd_id;
+	sync_start = dwt_cycles();
+
+	telemetry_sync_post(sync_cmd_id, sync_cmd_id < CMD_ID_COUNT ?
+					sync_predict_us[sync_cmd_id] : 0);
+}
+
+/* Mailbox commands only run with the CORE DPLL locked */
 void timer_sync(void)
 {
+	unsigned int cycles = dwt_cycles() - sync_start;
+	unsigned int khz = cm3_clk_khz();
+	unsigned int stat = msg_read(STAT_ID_REG) >> 16;
+	unsigned int predict;
+	unsigned int us;
+
+	us = khz ? cycles / khz * 1000 + cycles % khz * 1000 / khz : 0;
+
+	us = min(us, 0xffff);
+
+	if (sync_cmd_id < CMD_ID_COUNT) {
+		predict = sync_predict_us[sync_cmd_id];
+		sync_predict_us[sync_cmd_id] = max(us, predict - predict / 8);
+	}
 
+	telemetry_sync_done(stat, us);
+	mailbox_post(sync_cmd_id, stat);
 }
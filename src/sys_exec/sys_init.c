@@ -16,6 +16,8 @@
 #include <msg.h>
 #include <trace.h>
 #include <sync.h>
+#include <pm_handlers.h>
+#include <telemetry.h>
 
 int am335_init(void)
 {
@@ -39,9 +41,13 @@ int am335_init(void)
 	if (soc_id == AM43XX_SOC_ID)
 		nvic_disable_irq(CM3_IRQ_TPM_WAKE);
 
+	pm_nvic_init();
+
 	/* Clean the IPC registers */
 	m3_param_reset();
 
+	telemetry_init();
+
 	trace_init();
 
 	pm_reset();
@@ -0,0 +1,219 @@
+/*
+ * AM33XX-CM3 firmware
+ *
+ * Cortex-M3 (CM3) firmware for power management on Texas Instruments' AM33XX series of SoCs
+ *
+ * Copyright (C) 2011 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  This software is licensed under the  standard terms and conditions in the Texas Instruments  Incorporated
+ *  Technology and Software Publicly Available Software License Agreement , a copy of which is included in the
+ *  software download.
+*/
+
+#include <stddef.h>
+#include <counter32k.h>
+#include <timebase.h>
+#include <state_select.h>
+#include <telemetry.h>
+#include <stack.h>
+
+static volatile struct telemetry telemetry __attribute__ ((section(".telemetry")));
+
+/* Command currently being entered, and when */
+static enum cmd_ids entry_cmd_id = CMD_ID_INVALID;
+static unsigned int entry_start;
+
+static void telemetry_begin(void)
+{
+	telemetry.seq++;
+	__asm("dmb");
+}
+
+static void telemetry_end(void)
+{
+	__asm("dmb");
+	telemetry.seq++;
+}
+
+void telemetry_init(void)
+{
+	volatile unsigned int *p = (volatile unsigned int *) &telemetry;
+	int i;
+
+	/* Not part of .bss, survives until the A8 reloads the firmware */
+	for (i = 0; i < sizeof(telemetry) / 4; i++)
+		p[i] = 0;
+
+	telemetry.version = TELEMETRY_VERSION;
+	telemetry.size = sizeof(telemetry);
+	telemetry.stack_size = stack_size();
+	telemetry.magic = TELEMETRY_MAGIC;
+}
+
+void telemetry_cmd_invalid(void)
+{
+	telemetry_begin();
+	telemetry.cmds[CMD_ID_INVALID].failures++;
+	telemetry_end();
+}
+
+/* Called on the A8 WFI trigger, before the command handler runs */
+void telemetry_entry_start(enum cmd_ids id)
+{
+	entry_cmd_id = id;
+	entry_start = counter32k_read();
+}
+
+/*
+ * Entry ends with the last register write of the command handler. The
+ * DS handlers call this themselves before gating the WKUP clockdomain
+ * the 32K counter lives in, later calls are ignored.
+ */
+void telemetry_entry_done(void)
+{
+	volatile struct telemetry_cmd *cmd;
+	unsigned int us;
+
+	if (entry_cmd_id == CMD_ID_INVALID)
+		return;
+
+	us = timebase_ticks_to_us(counter32k_read() - entry_start);
+	us = min(us, 0xffff);
+	state_entry_latency_update(entry_cmd_id, us);
+
+	cmd = &telemetry.cmds[entry_cmd_id];
+	telemetry_begin();
+	cmd->entries++;
+	cmd->entry_us_total += us;
+	if (us > cmd->entry_us_max)
+		cmd->entry_us_max = us;
+	telemetry_end();
+
+	entry_cmd_id = CMD_ID_INVALID;
+}
+
+/* An entry backed out of, by a wake event or because it failed */
+void telemetry_entry_abort(bool failed)
+{
+	if (entry_cmd_id == CMD_ID_INVALID)
+		return;
+
+	telemetry_begin();
+	if (failed)
+		telemetry.cmds[entry_cmd_id].failures++;
+	else
+		telemetry.cmds[entry_cmd_id].aborts++;
+	telemetry_end();
+
+	entry_cmd_id = CMD_ID_INVALID;
+}
+
+/* Time from CM3 wakeup until the MPU gets released */
+void telemetry_exit_done(enum cmd_ids id, unsigned int us, bool failed)
+{
+	volatile struct telemetry_cmd *cmd = &telemetry.cmds[id];
+
+	us = min(us, 0xffff);
+
+	telemetry_begin();
+	cmd->exit_us_total += us;
+	if (us > cmd->exit_us_max)
+		cmd->exit_us_max = us;
+	if (failed)
+		cmd->failures++;
+	telemetry_end();
+
+	telemetry_stack_update();
+}
+
+/* Has to run before the NVIC gets flushed */
+void telemetry_wake(int irq)
+{
+	int idx = irq - TELEMETRY_WAKE_IRQ_BASE;
+
+	telemetry_begin();
+	if (idx >= 0 && idx < TELEMETRY_WAKE_IRQS)
+		telemetry.wake_irqs[idx]++;
+	wake_record_capture((struct wake_record *) &telemetry.wake, irq);
+	telemetry_end();
+}
+
+/* irqs is a bitmap of NVIC lines 32-63 */
+void telemetry_wake_late(unsigned int irqs)
+{
+	if (!irqs)
+		return;
+
+	telemetry_begin();
+	telemetry.late_wakes++;
+	telemetry.wake.late |= irqs;
+	telemetry_end();
+}
+
+void telemetry_pd_failure(enum powerdomain_id pd)
+{
+	telemetry_begin();
+	telemetry.pd_failures[pd]++;
+	telemetry_end();
+}
+
+void telemetry_idle_shallow(void)
+{
+	telemetry_begin();
+	telemetry.idle_shallow++;
+	telemetry_end();
+}
+
+/*
+ * Overflows are only caught after the fact, .bss may already be
+ * corrupted by then
+ */
+void telemetry_stack_update(void)
+{
+	unsigned int used = stack_high_water();
+
+	if (used == telemetry.stack_max)
+		return;
+
+	telemetry_begin();
+	telemetry.stack_max = used;
+	telemetry_end();
+
+	if (used >= telemetry.stack_size)
+		crash(CRASH_STACK_OVERFLOW);
+}
+
+void telemetry_sync_post(unsigned int cmd_id, unsigned int predicted_us)
+{
+	telemetry_begin();
+	telemetry.sync.cmds++;
+	telemetry.sync.cmd_id = cmd_id;
+	telemetry.sync.predicted_us = predicted_us;
+	telemetry.sync.done_us = 0;
+	telemetry_end();
+}
+
+/* A command that completes in under 1us still reports 1us */
+void telemetry_sync_done(unsigned int stat, unsigned int us)
+{
+	telemetry_begin();
+	telemetry.sync.stat = stat;
+	telemetry.sync.done_us = max(us, 1);
+	telemetry_end();
+}
+
+/* The crash path fills in the record in between */
+volatile struct crash_record *telemetry_crash_begin(void)
+{
+	/* A fault may have hit halfway through an update */
+	if (!(telemetry.seq & 1))
+		telemetry_begin();
+
+	return &telemetry.crash;
+}
+
+void telemetry_crash_end(void)
+{
+	telemetry.crash.magic = CRASH_MAGIC;
+	telemetry_end();
+}